@@ -12,9 +12,17 @@ module bootrom (
     data <= mem[addr];
   end
 
+`ifdef NO_BOOTROM_PLACEHOLDER
+  // Simulations may load another ROM with +bootrom=FILE.
+  reg [4095:0] bootrom_file;
+`endif
+
   initial begin
 `ifdef NO_BOOTROM_PLACEHOLDER
-    $readmemh("bootrom.hex", mem, 0, (1<<ADDR_W)-1);
+    if (!$value$plusargs("bootrom=%s", bootrom_file)) begin
+      bootrom_file = "bootrom.hex";
+    end
+    $readmemh(bootrom_file, mem, 0, (1<<ADDR_W)-1);
 `else
     $readmemh("bootrom.placeholder.hex", mem, 0, (1<<ADDR_W)-1);
 `endif
@@ -0,0 +1,28 @@
+// Character ROM
+//
+// The default font of 256 characters of 8 bytes each, one byte per pattern
+// row, laid out as a pattern table. As for the boot ROM, the contents are
+// substituted into the bitstream by icebram so the font can change without
+// resynthesis.
+module charrom (
+  input clk,
+  input [ADDR_W-1:0] addr,
+  output reg [7:0] data
+);
+  parameter ADDR_W = 11; // 2K
+
+  reg [7:0] mem [0:(1<<ADDR_W)-1];
+
+  always @(posedge clk)
+  begin
+    data <= mem[addr];
+  end
+
+  initial begin
+`ifdef NO_BOOTROM_PLACEHOLDER
+    $readmemh("charrom.hex", mem, 0, (1<<ADDR_W)-1);
+`else
+    $readmemh("charrom.placeholder.hex", mem, 0, (1<<ADDR_W)-1);
+`endif
+  end
+endmodule
@@ -3,131 +3,303 @@ module computer(
 
   output [7:0] io_port,
 
+  input uart_rx,
+  output uart_tx,
+
   output [3:0] r,
   output [3:0] g,
   output [3:0] b,
   output hsync,
-  output vsync
+  output vsync,
+  output de
 );
 
+// The CPU runs at clk / 2**CPU_DIV_W.
+parameter CPU_DIV_W = 2;
+
 // System lines
 wire reset;
 
 // CPU Bus
-wire cpu_clk;
+wire cpu_ce;      // CPU enabled on this clock, the last of each CPU cycle
+wire cpu_strobe;  // Bus access strobed on this clock, the one before
 wire [15:0] cpu_addr;
 reg [7:0] cpu_data_in;
-reg [7:0] cpu_data_in_next;  // Data to present to CPU on next clock cycle
 wire [7:0] cpu_data_out;
 wire cpu_writing;
 wire rdy;
+wire vdp_rdy;
+wire muldiv_rdy;
+wire irq;
+
+// System bus. The CPU drives the bus except while the DMA controller has
+// taken it, when the CPU is held by RDY.
+wire dma_bus;
+wire [15:0] dma_addr;
+wire dma_writing;
+wire [7:0] dma_data;
+wire [15:0] bus_addr = dma_bus ? dma_addr : cpu_addr;
+wire bus_writing = dma_bus ? dma_writing : cpu_writing;
+wire [7:0] bus_data_out = dma_bus ? dma_data : cpu_data_out;
+reg [7:0] bus_data_in;
 
 // IO data lines
 wire [7:0] rom_data;
 wire [7:0] ram_data;
 wire [7:0] vdp_data_out;
+wire [7:0] muldiv_data_out;
+wire [7:0] perf_data_out;
+wire [7:0] dma_data_out;
+wire [7:0] uart_data_out;
+wire [7:0] banked_ram_data;
+
+// VDP events counted by the performance counters
+wire vram_write_done;
+wire vblank_start;
+
+// Interrupt sources
+wire vdp_irq;
+wire dma_irq;
 
 // IO port
 reg [7:0] io_port;
 
+// Banked RAM. The SPRAM block not used for RAM or VRAM provides four 8K
+// banks, one of which is visible in the window at a time.
+reg [1:0] ram_bank;
+
 // Address decoding
-wire rom_select = cpu_addr[15:13] == 3'b111;        // $E000-$FFFF
-wire vdp_select = cpu_addr[15:8] == 8'b1100_0000;   // $C000-$C0FF
-wire io_select = cpu_addr == 16'h8400;              // $8400
-wire ram_select = ~rom_select && ~vdp_select && ~io_select;
+wire rom_select = bus_addr[15:13] == 3'b111;        // $E000-$FFFF
+wire vdp_select = bus_addr[15:8] == 8'b1100_0000;   // $C000-$C0FF
+wire muldiv_select = bus_addr[15:8] == 8'b1100_0001; // $C100-$C1FF
+wire bank_select = bus_addr[15:13] == 3'b101;       // $A000-$BFFF
+wire io_select = bus_addr == 16'h8400;              // $8400
+wire ram_bank_select = bus_addr == 16'h8401;        // $8401
+wire uart_select = bus_addr[15:3] == 13'h1081;      // $8408-$840F
+wire dma_select = bus_addr[15:3] == 13'h1082;       // $8410-$8417
+wire perf_select = bus_addr[15:5] == 11'h421;       // $8420-$843F
+wire ram_select = ~rom_select && ~vdp_select && ~io_select &&
+                  ~bank_select && ~ram_bank_select && ~muldiv_select &&
+                  ~uart_select && ~dma_select && ~perf_select;
+
+// Either peripheral may stall the CPU, as does the DMA controller while it
+// has the bus
+assign rdy = vdp_rdy && muldiv_rdy && ~dma_bus;
+assign irq = vdp_irq || dma_irq;
 
 // System reset line
 reset_timer system_reset_timer(.clk(clk), .reset(reset));
 
 // Clock generation
-cpu_clock_generator cpu_clock_generator(.clk(clk), .cpu_clk(cpu_clk));
+cpu_clock_generator #(.CPU_DIV_W(CPU_DIV_W)) cpu_clock_generator(
+  .clk(clk),
+  .cpu_ce(cpu_ce),
+  .cpu_strobe(cpu_strobe)
+);
+
+// Data read from the bus
+always @* begin
+  if(rom_select) begin
+    bus_data_in = rom_data;
+  end else if(vdp_select) begin
+    bus_data_in = vdp_data_out;
+  end else if(muldiv_select) begin
+    bus_data_in = muldiv_data_out;
+  end else if(bank_select) begin
+    bus_data_in = banked_ram_data;
+  end else if(ram_bank_select) begin
+    bus_data_in = {6'b0, ram_bank};
+  end else if(uart_select) begin
+    bus_data_in = uart_data_out;
+  end else if(dma_select) begin
+    bus_data_in = dma_data_out;
+  end else if(perf_select) begin
+    bus_data_in = perf_data_out;
+  end else begin
+    bus_data_in = ram_data;
+  end
+end
 
-// Latch CPU data in line while CPU reading
+// Latch CPU data in line while CPU reading. The ROM and RAM return data a
+// clock after the address so it is ready by the end of the cycle, when it is
+// registered into DI on the same clock as the CPU. This is the synchronous
+// memory the CPU expects. A cycle which ends with RDY low is repeated by the
+// CPU so DI, and any address the CPU derives from it, is held while stalled.
 always @(posedge clk)
 begin
-  if(~cpu_writing && ~cpu_clk) begin
-    if(rom_select) begin
-      cpu_data_in_next <= rom_data;
-    end else if(vdp_select) begin
-      cpu_data_in_next <= vdp_data_out;
-    end else begin
-      cpu_data_in_next <= ram_data;
-    end
-  end else if(cpu_clk) begin
-    cpu_data_in <= cpu_data_in_next;
+  if(cpu_ce && rdy && ~bus_writing) begin
+    cpu_data_in <= bus_data_in;
   end
 end
 
-// The CPU itself.
-cpu_65c02 cpu(
+// The CPU itself. It is clocked by clk and RDY doubles as its clock enable.
+// The core is chosen at build time, see cpu_core.v.
+cpu_core cpu(
   .reset(reset),
-  .clk(cpu_clk),
+  .clk(clk),
 
   .NMI(1'b0),
-  .IRQ(1'b0),
-  .RDY(rdy),
+  .IRQ(irq),
+  .RDY(rdy && cpu_ce),
 
   .AB(cpu_addr),
   .WE(cpu_writing),
   .DI(cpu_data_in),
+  .BUS_DI(bus_data_in),
   .DO(cpu_data_out)
 );
 
 // Boot ROM
 bootrom rom(
   .clk(clk),
-  .addr(cpu_addr[12:0]),
+  .addr(bus_addr[12:0]),
   .data(rom_data)
 );
 
 spram32k8 ram_bank_1(
   .clk(clk),
-  .addr(cpu_addr[14:0]),
-  .write_enable(~cpu_clk && cpu_writing && (~cpu_addr[15])),
-  .data_in(cpu_data_out),
+  .addr(bus_addr[14:0]),
+  .write_enable(cpu_strobe && bus_writing && (~bus_addr[15])),
+  .data_in(bus_data_out),
   .data_out(ram_data)
 );
 
+spram32k8 ram_bank_2(
+  .clk(clk),
+  .addr({ram_bank, bus_addr[12:0]}),
+  .write_enable(cpu_strobe && bus_writing && bank_select),
+  .data_in(bus_data_out),
+  .data_out(banked_ram_data)
+);
+
 // Latch writes to IO port.
 always @(posedge clk) begin
   if(reset) begin
     io_port <= 8'h00;
-  end else if(~cpu_clk && cpu_writing && io_select) begin
-    io_port <= cpu_data_out;
+  end else if(cpu_strobe && bus_writing && io_select) begin
+    io_port <= bus_data_out;
+  end
+end
+
+// Latch writes to RAM bank select.
+always @(posedge clk) begin
+  if(reset) begin
+    ram_bank <= 2'b00;
+  end else if(cpu_strobe && bus_writing && ram_bank_select) begin
+    ram_bank <= bus_data_out[1:0];
   end
 end
 
-wire vdp_read = ~cpu_writing && ~cpu_clk && vdp_select;
-wire vdp_write = cpu_writing && ~cpu_clk && vdp_select;
+wire vdp_read = ~bus_writing && cpu_strobe && vdp_select;
+wire vdp_write = bus_writing && cpu_strobe && vdp_select;
 
 vdp vdp(
   .reset(reset),
   .clk(clk),
-  .rdy(rdy),
+  .rdy(vdp_rdy),
+  .irq(vdp_irq),
+  .vram_write_done(vram_write_done),
+  .vblank_start(vblank_start),
 
-  .mode(cpu_addr[1:0]),
+  .mode(bus_addr[1:0]),
   .read(vdp_read),
   .write(vdp_write),
-  .data_in(cpu_data_out),
+  .data_in(bus_data_out),
   .data_out(vdp_data_out),
 
-  .r(r), .g(g), .b(b), .hsync(hsync), .vsync(vsync)
+  .r(r), .g(g), .b(b), .hsync(hsync), .vsync(vsync), .de(de)
+);
+
+wire muldiv_read = ~bus_writing && cpu_strobe && muldiv_select;
+wire muldiv_write = bus_writing && cpu_strobe && muldiv_select;
+
+muldiv muldiv(
+  .reset(reset),
+  .clk(clk),
+  .rdy(muldiv_rdy),
+
+  .addr(bus_addr[3:0]),
+  .read(muldiv_read),
+  .write(muldiv_write),
+  .data_in(bus_data_out),
+  .data_out(muldiv_data_out)
+);
+
+perf_counters perf(
+  .reset(reset),
+  .clk(clk),
+  .cpu_ce(cpu_ce),
+  .rdy(rdy),
+
+  .rom_cycle(rom_select),
+  .ram_cycle(ram_select || bank_select),
+  .vdp_cycle(vdp_select),
+  .io_cycle(io_select || ram_bank_select || muldiv_select || uart_select ||
+    dma_select || perf_select),
+  .vram_write(vram_write_done),
+  .frame(vblank_start),
+
+  .addr(bus_addr[4:0]),
+  .write(bus_writing && cpu_strobe && perf_select),
+  .data_in(bus_data_out),
+  .data_out(perf_data_out)
+);
+
+wire uart_read = ~bus_writing && cpu_strobe && uart_select;
+wire uart_write = bus_writing && cpu_strobe && uart_select;
+
+uart uart(
+  .reset(reset),
+  .clk(clk),
+
+  .addr(bus_addr[2:0]),
+  .read(uart_read),
+  .write(uart_write),
+  .data_in(bus_data_out),
+  .data_out(uart_data_out),
+
+  .rx(uart_rx),
+  .tx(uart_tx)
+);
+
+dma dma(
+  .reset(reset),
+  .clk(clk),
+  .cpu_ce(cpu_ce),
+  .irq(dma_irq),
+
+  .addr(bus_addr[2:0]),
+  .write(bus_writing && cpu_strobe && dma_select),
+  .data_in(bus_data_out),
+  .data_out(dma_data_out),
+
+  .bus(dma_bus),
+  .bus_addr(dma_addr),
+  .bus_writing(dma_writing),
+  .bus_data_out(dma_data),
+  .bus_data_in(bus_data_in),
+  .vdp_rdy(vdp_rdy)
 );
 
 endmodule
 
 module cpu_clock_generator(
   input clk,
-  output cpu_clk
+  output cpu_ce,
+  output cpu_strobe
 );
 
-// Derive CPU clock from system clock
+// Derive CPU cycles from system clock. A CPU cycle is 2**CPU_DIV_W clocks.
+// The CPU is enabled on the last clock of each cycle. Bus accesses are strobed
+// on the clock before so that peripherals can decide RDY before the CPU
+// samples it.
 parameter CPU_DIV_W = 2;
 
 reg [CPU_DIV_W-1:0] cpu_clk_ctr = 0;
 
-assign cpu_clk = cpu_clk_ctr[CPU_DIV_W-1];
+assign cpu_ce = &cpu_clk_ctr;
+assign cpu_strobe = (cpu_clk_ctr + 1'b1) == {CPU_DIV_W{1'b1}};
 
-always @(posedge clk) cpu_clk_ctr = cpu_clk_ctr + 1;
+always @(posedge clk) cpu_clk_ctr <= cpu_clk_ctr + 1;
 
 endmodule
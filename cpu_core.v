@@ -0,0 +1,96 @@
+// CPU core
+//
+// Selects one of the three 6502 cores in the tree by define, presenting each
+// with the interface of Arlet Ottens' cores:
+//
+//   CPU_CORE_65c02   cpu/cpu_65c02.v (default)
+//   CPU_CORE_6502    cpu/cpu.v, the original NMOS 6502 core
+//   CPU_CORE_bc6502  bc6502/bc6502.v
+//
+// The Arlet cores drive AB for the current cycle and expect the data read on
+// DI in the cycle after, as from synchronous memory. bc6502 expects
+// asynchronous memory: it drives a registered address for the whole cycle and
+// takes the data at the end of it. It is given BUS_DI, the data on the bus at
+// the end of the current cycle, instead of DI.
+//
+// RDY doubles as the clock enable of every core.
+`ifdef CPU_CORE_bc6502
+// bc6502 names a port "do", which is a SystemVerilog keyword.
+`ifndef SYNTHESIS
+`begin_keywords "1364-2005"
+`endif
+`include "bc6502/bc6502.v"
+`include "bc6502/addsub.v"
+`ifndef SYNTHESIS
+`end_keywords
+`endif
+`endif
+
+module cpu_core(
+  input clk,
+  input reset,
+  output [15:0] AB,
+  input [7:0] DI,
+  input [7:0] BUS_DI,
+  output [7:0] DO,
+  output WE,
+  input IRQ,
+  input NMI,
+  input RDY
+);
+
+`ifdef CPU_CORE_bc6502
+
+wire rw;
+
+assign WE = ~rw;
+
+bc6502 core(
+  .reset(reset),
+  .clk(clk),
+  .nmi(NMI),
+  .irq(IRQ),
+  .rdy(RDY),
+  .so(1'b0),
+  .di(BUS_DI),
+  .do(DO),
+  .rw(rw),
+  .ma(AB),
+  .rw_nxt(),
+  .ma_nxt(),
+  .sync(),
+  .state(),
+  .flags()
+);
+
+`elsif CPU_CORE_6502
+
+cpu core(
+  .clk(clk),
+  .reset(reset),
+  .AB(AB),
+  .DI(DI),
+  .DO(DO),
+  .WE(WE),
+  .IRQ(IRQ),
+  .NMI(NMI),
+  .RDY(RDY)
+);
+
+`else
+
+cpu_65c02 core(
+  .clk(clk),
+  .reset(reset),
+  .AB(AB),
+  .DI(DI),
+  .DO(DO),
+  .WE(WE),
+  .IRQ(IRQ),
+  .NMI(NMI),
+  .RDY(RDY)
+);
+
+`endif
+
+endmodule
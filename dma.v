@@ -0,0 +1,180 @@
+// DMA controller
+//
+// Copies a block from anywhere in the CPU address space into VRAM. While a
+// transfer runs the controller holds the CPU with RDY and drives the system
+// bus itself, one bus cycle per CPU cycle. It first sets the VDP write address
+// and then alternates between reading a byte from the source and writing it
+// to the VDP data port. A write which the VDP stalls is repeated as the CPU
+// would repeat it.
+//
+// The VDP write address is set through the VDP register select and data
+// ports, so after a transfer VDP register 3 is selected and the write address
+// is the destination plus the length. Neither is restored.
+//
+// The done flag is set when a transfer finishes and raises an interrupt if
+// enabled.
+//
+// Registers:
+//
+//   0-1  source address
+//   2-3  VRAM destination address
+//   4-5  length
+//   6    write: bit 0 starts a transfer, bit 1 enables the interrupt and
+//               writing a 1 to bit 6 acknowledges done
+//        read: {busy, done, 4'b0, irq enable, 1'b0}
+module dma(
+  input reset,
+  input clk,
+  input cpu_ce,
+  output irq,
+
+  input [2:0] addr,
+  input write,
+  input [7:0] data_in,
+  output [7:0] data_out,
+
+  output reg bus,
+  output reg [15:0] bus_addr,
+  output reg bus_writing,
+  output reg [7:0] bus_data_out,
+  input [7:0] bus_data_in,
+  input vdp_rdy
+);
+
+localparam VDP_REGISTER_SELECT = 16'hC000;
+localparam VDP_REGISTER_DATA = 16'hC001;
+localparam VDP_VRAM_DATA = 16'hC002;
+
+localparam STATE_IDLE = 0;
+localparam STATE_SELECT_ADDR_L = 1;
+localparam STATE_ADDR_L = 2;
+localparam STATE_SELECT_ADDR_H = 3;
+localparam STATE_ADDR_H = 4;
+localparam STATE_READ = 5;
+localparam STATE_WRITE = 6;
+
+reg [15:0]  src;
+reg [15:0]  dst;
+reg [15:0]  length;
+reg         irq_enable;
+reg         done;
+reg         start;
+
+reg [2:0]   state;
+reg [15:0]  src_ctr;
+reg [15:0]  remaining;
+
+// Like the CPU, each bus cycle ends on a clock with cpu_ce set. The result of
+// the cycle is known at this point and the next cycle is set up.
+wire cycle_end = cpu_ce;
+
+wire busy = start || (state != STATE_IDLE);
+
+assign irq = done && irq_enable;
+assign data_out = (addr == 6) ? {busy, done, 4'b0, irq_enable, 1'b0} : 8'h00;
+
+always @(posedge clk) begin
+  if(reset) begin
+    src <= 0;
+    dst <= 0;
+    length <= 0;
+    irq_enable <= 0;
+    done <= 0;
+    start <= 0;
+
+    state <= STATE_IDLE;
+    src_ctr <= 0;
+    remaining <= 0;
+    bus <= 0;
+    bus_addr <= 0;
+    bus_writing <= 0;
+    bus_data_out <= 0;
+  end else begin
+    if(write) begin
+      case(addr)
+        0: src[7:0] <= data_in;
+        1: src[15:8] <= data_in;
+        2: dst[7:0] <= data_in;
+        3: dst[15:8] <= data_in;
+        4: length[7:0] <= data_in;
+        5: length[15:8] <= data_in;
+        6: irq_enable <= data_in[1];
+      endcase
+    end
+
+    // The transfer takes the bus from the start of the next CPU cycle.
+    if(write && (addr == 6) && data_in[0] && (length != 0)) begin
+      start <= 1;
+    end
+
+    if(write && (addr == 6) && data_in[6]) begin
+      done <= 0;
+    end
+
+    if(cycle_end) begin
+      case(state)
+        STATE_IDLE: begin
+          if(start) begin
+            start <= 0;
+            src_ctr <= src;
+            remaining <= length;
+            state <= STATE_SELECT_ADDR_L;
+            bus <= 1;
+            bus_addr <= VDP_REGISTER_SELECT;
+            bus_writing <= 1;
+            bus_data_out <= 8'h02;
+          end
+        end
+
+        STATE_SELECT_ADDR_L: begin
+          state <= STATE_ADDR_L;
+          bus_addr <= VDP_REGISTER_DATA;
+          bus_data_out <= dst[7:0];
+        end
+
+        // The VDP stalls write address changes until queued writes drain.
+        STATE_ADDR_L: if(vdp_rdy) begin
+          state <= STATE_SELECT_ADDR_H;
+          bus_addr <= VDP_REGISTER_SELECT;
+          bus_data_out <= 8'h03;
+        end
+
+        STATE_SELECT_ADDR_H: begin
+          state <= STATE_ADDR_H;
+          bus_addr <= VDP_REGISTER_DATA;
+          bus_data_out <= dst[15:8];
+        end
+
+        STATE_ADDR_H: if(vdp_rdy) begin
+          state <= STATE_READ;
+          bus_addr <= src_ctr;
+          bus_writing <= 0;
+        end
+
+        STATE_READ: begin
+          state <= STATE_WRITE;
+          src_ctr <= src_ctr + 1;
+          bus_addr <= VDP_VRAM_DATA;
+          bus_writing <= 1;
+          bus_data_out <= bus_data_in;
+        end
+
+        STATE_WRITE: if(vdp_rdy) begin
+          remaining <= remaining - 1;
+          if(remaining == 1) begin
+            state <= STATE_IDLE;
+            bus <= 0;
+            bus_writing <= 0;
+            done <= 1;
+          end else begin
+            state <= STATE_READ;
+            bus_addr <= src_ctr;
+            bus_writing <= 0;
+          end
+        end
+      endcase
+    end
+  end
+end
+
+endmodule
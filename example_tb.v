@@ -6,10 +6,23 @@ module testbench;
   reg clk = 1;
   always #(1000.0 / (63*2)) clk = ~clk;
 
+  wire [3:0] r, g, b;
+  wire hsync, vsync;
+
   computer computer(
-    .clk(clk)
+    .clk(clk),
+    .uart_rx(1'b1),
+    .r(r), .g(g), .b(b), .hsync(hsync), .vsync(vsync)
+  );
+
+  vga_capture capture(
+    .dot_clk(computer.vdp.dot_clk),
+    .de(computer.vdp.visible),
+    .r(r), .g(g), .b(b), .hsync(hsync), .vsync(vsync)
   );
 
+  integer cycles;
+
   reg [4095:0] vcdfile;
 
   initial begin
@@ -19,8 +32,21 @@ module testbench;
     end
   end
 
+  // A frame is a little under 1,000,000 cycles. Pass +cycles=<n> to run for
+  // long enough to capture some.
   initial begin
-    repeat (100000) @(posedge clk);
+    if (!$value$plusargs("cycles=%d", cycles)) begin
+      cycles = 100000;
+    end
+    repeat (cycles) @(posedge clk);
+
+    $display("perf: cpu cycles %0d, rdy low %0d",
+      computer.perf.counter[0], computer.perf.counter[1]);
+    $display("perf: rom %0d, ram %0d, vdp %0d, io %0d",
+      computer.perf.counter[2], computer.perf.counter[3],
+      computer.perf.counter[4], computer.perf.counter[5]);
+    $display("perf: vram writes %0d, frames %0d",
+      computer.perf.counter[6], computer.perf.counter[7]);
     $finish;
   end
 endmodule
@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+"""
+Convert a font image into VDP pattern data.
+
+The image is a grid of 8x8 characters, read left to right and top to bottom.
+Each character becomes 8 bytes, one per row, with the leftmost pixel in the
+most significant bit. A pixel which is not white is set.
+
+Usage: make-font.py [--bin FILE] [--hex FILE] IMAGE
+
+--hex writes one byte per line in the format read by $readmemh and icebram.
+"""
+import argparse
+
+import imageio
+import numpy as np
+
+
+def load_font(path):
+    font = np.asarray(imageio.imread(path))
+    font = np.where(np.atleast_3d(font)[..., 0] == 255, 1, 0)
+
+    n_rows = font.shape[0] // 8
+    font = (font.reshape((font.shape[0], -1, 8))
+            .transpose([1, 0, 2])
+            .reshape((-1, n_rows, 8*8))
+            .transpose([1, 0, 2])
+            .reshape((-1, 8))
+           )
+
+    vals = np.zeros((font.shape[0],), np.uint8)
+    for col in range(8):
+        vals |= np.where(font[:, col], 0, 1<<(7-col)).astype(np.uint8)
+    return vals
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert a font image into VDP pattern data')
+    parser.add_argument('--bin', help='write raw pattern bytes to this file')
+    parser.add_argument('--hex', help='write a hex file for the character ROM')
+    parser.add_argument('image', help='font image')
+    args = parser.parse_args()
+
+    vals = load_font(args.image)
+
+    if args.bin is not None:
+        with open(args.bin, 'wb') as f:
+            f.write(vals.tobytes())
+
+    if args.hex is not None:
+        with open(args.hex, 'w') as f:
+            for v in vals:
+                print(f'{v:02x}', file=f)
+
+
+if __name__ == '__main__':
+    main()
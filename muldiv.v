@@ -0,0 +1,131 @@
+// Multiply/divide unit
+//
+// Operands are written to A (32 bits) and B (16 bits). The product A[15:0] * B
+// and the quotient and remainder of A / B may then be read back. Writing the
+// low byte of an operand clears its upper bytes so that narrower operands need
+// only their low bytes written.
+//
+// The multiplier is a single registered 16x16 multiply which maps onto an
+// SB_MAC16 DSP block. Its result is ready on the next clock. Division is
+// restoring division at one bit per clock, started at the end of each operand
+// write. It takes 16 clocks if A[31:16] is zero and 32 clocks otherwise.
+// Reading the quotient or remainder before it is complete holds RDY low.
+//
+// Dividing by zero gives a quotient of all ones, only in the low 16 bits if
+// A[31:16] is zero, and a remainder of A[15:0].
+//
+// Registers:
+//
+//   addr   write       read
+//   0-3    A           product
+//   4-5    B           quotient (4-7)
+//   8-9                remainder
+module muldiv(
+  input reset,
+  input clk,
+
+  input [3:0] addr,
+  input read,
+  input write,
+  input [7:0] data_in,
+  output reg [7:0] data_out,
+
+  output reg rdy
+);
+
+reg [31:0]  operand_a;
+reg [15:0]  operand_b;
+reg [31:0]  product;
+
+// Division state. The dividend is shifted out of the top of quotient as
+// quotient bits are shifted in at the bottom.
+reg [31:0]  quotient;
+reg [15:0]  remainder;
+reg [5:0]   div_count;
+wire        div_busy = div_count != 0;
+
+wire [16:0] div_shifted = {remainder, quotient[31]};
+wire [17:0] div_diff = {1'b0, div_shifted} - {2'b0, operand_b};
+
+reg write_reg;
+reg read_reg;
+
+always @* begin
+  case(addr)
+    0: data_out = product[7:0];
+    1: data_out = product[15:8];
+    2: data_out = product[23:16];
+    3: data_out = product[31:24];
+    4: data_out = quotient[7:0];
+    5: data_out = quotient[15:8];
+    6: data_out = quotient[23:16];
+    7: data_out = quotient[31:24];
+    8: data_out = remainder[7:0];
+    9: data_out = remainder[15:8];
+    default: data_out = 8'h00;
+  endcase
+end
+
+always @(posedge clk) begin
+  product <= operand_a[15:0] * operand_b;
+end
+
+always @(posedge clk) begin
+  if(reset) begin
+    operand_a <= 0;
+    operand_b <= 0;
+    quotient <= 0;
+    remainder <= 0;
+    div_count <= 0;
+
+    write_reg <= 0;
+    read_reg <= 0;
+
+    rdy <= 1;
+  end else begin
+    if(write) begin
+      case(addr)
+        0: operand_a <= {24'b0, data_in};
+        1: operand_a[15:8] <= data_in;
+        2: operand_a[23:16] <= data_in;
+        3: operand_a[31:24] <= data_in;
+        4: operand_b <= {8'b0, data_in};
+        5: operand_b[15:8] <= data_in;
+      endcase
+    end
+
+    if(~write && write_reg) begin
+      remainder <= 0;
+      if(operand_a[31:16] == 0) begin
+        quotient <= {operand_a[15:0], 16'b0};
+        div_count <= 16;
+      end else begin
+        quotient <= operand_a;
+        div_count <= 32;
+      end
+    end else if(div_busy) begin
+      if(div_diff[17]) begin
+        remainder <= div_shifted[15:0];
+        quotient <= {quotient[30:0], 1'b0};
+      end else begin
+        remainder <= div_diff[15:0];
+        quotient <= {quotient[30:0], 1'b1};
+      end
+      div_count <= div_count - 1;
+    end
+
+    // Stall the CPU if it reads the quotient or remainder while a division
+    // is in progress. As in the VDP this is decided once at the start of each
+    // read so that RDY is stable when the CPU samples it.
+    if(read && ~read_reg) begin
+      rdy <= ~(div_busy && (addr >= 4));
+    end else if(~read) begin
+      rdy <= 1;
+    end
+
+    write_reg <= write;
+    read_reg <= read;
+  end
+end
+
+endmodule
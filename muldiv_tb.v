@@ -0,0 +1,176 @@
+`timescale 1ns/100ps
+
+module testbench;
+  // 63MHz clock
+  reg clk = 1;
+  always #(1000.0 / (63*2)) clk = ~clk;
+
+  // Derive CPU clock from system clock
+  parameter CPU_DIV_W = 2;
+  reg [CPU_DIV_W-1:0] cpu_clk_ctr = 0;
+  wire cpu_clk = cpu_clk_ctr[CPU_DIV_W-1];
+  always @(posedge clk) cpu_clk_ctr = cpu_clk_ctr + 1;
+
+  // Multiply/divide unit interface
+  reg reset = 0;
+  reg [3:0] addr = 0;
+  reg read = 0;
+  reg write = 0;
+  reg [7:0] data_in = 0;
+  wire [7:0] data_out;
+  wire rdy;
+
+  // Reads and writes are strobed while cpu_clk is low. computer.v strobes each
+  // access for only the clock before the end of the CPU cycle and peripherals
+  // must behave the same for either.
+  muldiv muldiv(
+    .clk(clk),
+    .reset(reset),
+    .rdy(rdy),
+
+    .addr(addr),
+    .read(read && ~cpu_clk),
+    .write(write && ~cpu_clk),
+    .data_in(data_in),
+    .data_out(data_out)
+  );
+
+  // CPU cycle accounting
+  integer cpu_cycles = 0;
+  integer stall_cycles = 0;
+  integer errors = 0;
+
+  task cpu_write(input [3:0] write_addr, input [7:0] value);
+    begin
+      addr = write_addr;
+      data_in = value;
+      write = 1;
+      @(posedge cpu_clk);
+      cpu_cycles = cpu_cycles + 1;
+      @(negedge cpu_clk);
+      write = 0;
+    end
+  endtask
+
+  // Perform a single CPU read cycle. Like the 65C02, the read is repeated for
+  // as long as RDY is held low.
+  task cpu_read(input [3:0] read_addr, output [7:0] value);
+    begin
+      addr = read_addr;
+      read = 1;
+      @(posedge cpu_clk);
+      cpu_cycles = cpu_cycles + 1;
+      while(~rdy) begin
+        stall_cycles = stall_cycles + 1;
+        cpu_cycles = cpu_cycles + 1;
+        @(posedge cpu_clk);
+      end
+      value = data_out;
+      @(negedge cpu_clk);
+      read = 0;
+    end
+  endtask
+
+  task cpu_idle(input integer cycles);
+    begin
+      repeat (cycles) @(negedge cpu_clk);
+      cpu_cycles = cpu_cycles + cycles;
+    end
+  endtask
+
+  reg [31:0] product;
+  reg [31:0] quotient;
+  reg [15:0] remainder;
+
+  // Write both operands as the runtime routines do, lowest byte first and
+  // skipping zero upper bytes of A, and check every result. The CPU idles for
+  // three cycles between the last store and the first load as it does when
+  // executing an absolute load.
+  task check(input [31:0] a, input [15:0] b);
+    reg [31:0] expected_quotient;
+    reg [15:0] expected_remainder;
+    begin
+      cpu_write(0, a[7:0]);
+      cpu_write(1, a[15:8]);
+      if(a[31:16] != 0) begin
+        cpu_write(2, a[23:16]);
+        cpu_write(3, a[31:24]);
+      end
+      cpu_write(4, b[7:0]);
+      cpu_write(5, b[15:8]);
+
+      cpu_idle(3);
+      cpu_cycles = 0;
+      stall_cycles = 0;
+      cpu_read(0, product[7:0]);
+      cpu_read(1, product[15:8]);
+      cpu_read(2, product[23:16]);
+      cpu_read(3, product[31:24]);
+      cpu_read(4, quotient[7:0]);
+      cpu_read(5, quotient[15:8]);
+      cpu_read(6, quotient[23:16]);
+      cpu_read(7, quotient[31:24]);
+      cpu_read(8, remainder[7:0]);
+      cpu_read(9, remainder[15:8]);
+
+      if(b == 0) begin
+        expected_quotient = (a[31:16] == 0) ? 32'h0000FFFF : 32'hFFFFFFFF;
+        expected_remainder = a[15:0];
+      end else begin
+        expected_quotient = a / b;
+        expected_remainder = a % b;
+      end
+
+      if(product != a[15:0] * b) begin
+        $display("ERROR: %0d * %0d = %0d, expected %0d", a[15:0], b, product, a[15:0] * b);
+        errors = errors + 1;
+      end
+      if((quotient != expected_quotient) || (remainder != expected_remainder)) begin
+        $display("ERROR: %0d / %0d = %0d r %0d, expected %0d r %0d",
+          a, b, quotient, remainder, expected_quotient, expected_remainder);
+        errors = errors + 1;
+      end
+
+      $display("%0d, %0d: %0d CPU cycles stalled reading results", a, b, stall_cycles);
+    end
+  endtask
+
+  reg [4095:0] vcdfile;
+
+  initial begin
+    if ($value$plusargs("vcd=%s", vcdfile)) begin
+      $dumpfile(vcdfile);
+      $dumpvars(0, testbench);
+    end
+  end
+
+  integer n;
+
+  initial begin
+    reset = 1;
+    repeat (10) @(posedge cpu_clk);
+    reset = 0;
+    repeat (1) @(negedge cpu_clk);
+
+    check(0, 0);
+    check(1234, 56);
+    check(65535, 65535);
+    check(65535, 1);
+    check(40000, 0);
+    check(32'h12345678, 16'h9ABC);
+    check(32'hFFFFFFFF, 16'h0001);
+    check(32'h7FFF0000, 16'h8000);
+
+    for(n=0; n<32; n=n+1) begin
+      check($random, $random);
+    end
+
+    if(errors == 0) begin
+      $display("All multiply/divide checks passed");
+    end else begin
+      $display("%0d multiply/divide checks failed", errors);
+    end
+
+    $finish;
+  end
+endmodule
@@ -0,0 +1,204 @@
+// CPU core benchmark. Runs kernels built on the C runtime, times each with the
+// performance counters and reports a line per kernel over the UART:
+//
+//     kernel <name> cycles <CPU cycles> pass|fail
+//
+// then a line per multiply or divide operation giving its average cycles:
+//
+//     routine <name> cycles <CPU cycles>
+//
+// followed by "done", after which the IO port is set to BENCH_DONE. The
+// benchmark is built for the NMOS 6502 so that every core can run it. See
+// tools/cpu-bench.py.
+#include <cc65.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "perf.h"
+#include "types.h"
+#include "uart.h"
+
+#define IO_PORT (*((volatile u8*)0x8400))
+#define BENCH_DONE 0xFF
+
+// Buffers for the memory copy kernel, in the USR region
+#define COPY_LEN 0x1000
+#define COPY_SRC ((u8*)0xE000)
+#define COPY_DST1 ((u8*)0x1000)
+#define COPY_DST2 ((u8*)0x2000)
+
+// Sum of the first 1000 values from rand() after srand(1)
+#define RAND_COUNT 1000
+#define RAND_SUM 0x3A67
+
+static void uart_putc(char c) {
+    while(UART_STATUS & UART_TX_FULL) { }
+    UART_DATA = c;
+}
+
+static void uart_puts(const char *s) {
+    while(*s) {
+        uart_putc(*s++);
+    }
+}
+
+// Each product is checked against a running sum.
+static u8 mul16(void) {
+    u16 a, b, product, sum;
+    u8 ok = 1;
+
+    for(a=1; a<60000U; a+=4999) {
+        sum = 0;
+        for(b=0; b<64; ++b) {
+            product = a * b;
+            if(product != sum) {
+                ok = 0;
+            }
+            sum += a;
+        }
+    }
+    return ok;
+}
+
+// Each quotient and remainder is checked by multiplying back.
+static u8 div16(void) {
+    u16 n, d, q, r;
+    u8 ok = 1;
+
+    for(n=7; n<65000U; n+=251) {
+        d = (n & 0xFF) + 1;
+        q = n / d;
+        r = n % d;
+        if((r >= d) || (q * d + r != n)) {
+            ok = 0;
+        }
+    }
+    return ok;
+}
+
+static u8 div32(void) {
+    u32 n, q;
+    u16 d, r;
+    u8 i;
+    u8 ok = 1;
+
+    n = 12345;
+    for(i=0; i<64; ++i) {
+        d = (u16)(n >> 8) | 1;
+        q = n / d;
+        r = n % d;
+        if((r >= d) || (q * d + r != n)) {
+            ok = 0;
+        }
+        n = n * 3 + 40503;
+    }
+    return ok;
+}
+
+static u8 rand_sum(void) {
+    u16 sum = 0;
+    u16 i;
+
+    srand(1);
+    for(i=0; i<RAND_COUNT; ++i) {
+        sum += rand();
+    }
+    return sum == RAND_SUM;
+}
+
+// Copy 4K from ROM to RAM and then within RAM.
+static u8 copy(void) {
+    memcpy(COPY_DST1, COPY_SRC, COPY_LEN);
+    memcpy(COPY_DST2, COPY_DST1, COPY_LEN);
+    return memcmp(COPY_DST2, COPY_SRC, COPY_LEN) == 0;
+}
+
+// Operations timed by routine(). Each is made ROUTINE_CALLS times on varying
+// operands with the result stored to sink. The names are the C runtime
+// routines the operations call.
+#define ROUTINE_CALLS 64
+
+#define ROUTINE_BASE            0
+#define ROUTINE_TOSUMULAX       1
+#define ROUTINE_UMUL8X8R16      2
+#define ROUTINE_UMUL16X16R32    3
+#define ROUTINE_TOSUDIVAX       4
+#define ROUTINE_TOSUDIVEAX      5
+
+static volatile u32 sink;
+
+static void routine_loop(u8 op) {
+    u16 a = 1, b = 3;
+    u32 n = 12345;
+    u8 i;
+
+    for(i=0; i<ROUTINE_CALLS; ++i) {
+        switch(op) {
+            case ROUTINE_BASE:         sink = a ^ b; break;
+            case ROUTINE_TOSUMULAX:    sink = a * b; break;
+            case ROUTINE_UMUL8X8R16:   sink = umul8x8r16((u8)a, (u8)b); break;
+            case ROUTINE_UMUL16X16R32: sink = umul16x16r32(a, b); break;
+            case ROUTINE_TOSUDIVAX:    sink = a / b; break;
+            case ROUTINE_TOSUDIVEAX:   sink = n / b; break;
+        }
+        a += 4999;
+        b += 251;
+        n += 0x12345;
+    }
+}
+
+static u32 routine_cycles(u8 op) {
+    perf_region region;
+
+    perf_begin(&region);
+    routine_loop(op);
+    perf_end(&region);
+    return region.cycles;
+}
+
+// Report the average cycles taken by an operation, less those taken by the
+// same loop storing an exclusive or. This includes passing the operands.
+static void routine(const char *name, u8 op) {
+    char number[11];
+    u32 cycles = routine_cycles(op) - routine_cycles(ROUTINE_BASE);
+
+    uart_puts("routine ");
+    uart_puts(name);
+    uart_puts(" cycles ");
+    uart_puts(ultoa(cycles / ROUTINE_CALLS, number, 10));
+    uart_puts("\r\n");
+}
+
+static void run(const char *name, u8 (*kernel)(void)) {
+    perf_region region;
+    char number[11];
+    u8 ok;
+
+    perf_begin(&region);
+    ok = kernel();
+    perf_end(&region);
+
+    uart_puts("kernel ");
+    uart_puts(name);
+    uart_puts(" cycles ");
+    uart_puts(ultoa(region.cycles, number, 10));
+    uart_puts(ok ? " pass\r\n" : " fail\r\n");
+}
+
+void bench(void) {
+    run("mul16", mul16);
+    run("div16", div16);
+    run("div32", div32);
+    run("rand", rand_sum);
+    run("memcpy", copy);
+    routine("tosumulax", ROUTINE_TOSUMULAX);
+    routine("umul8x8r16", ROUTINE_UMUL8X8R16);
+    routine("umul16x16r32", ROUTINE_UMUL16X16R32);
+    routine("tosudivax", ROUTINE_TOSUDIVAX);
+    routine("tosudiveax", ROUTINE_TOSUDIVEAX);
+    uart_puts("done\r\n");
+
+    while(!(UART_STATUS & UART_TX_EMPTY)) { }
+    IO_PORT = BENCH_DONE;
+    while(1) { }
+}
@@ -0,0 +1,64 @@
+; Reset handler and vectors for the CPU core benchmark. Like the OS reset
+; handler but using only NMOS 6502 instructions so that every core can run
+; it.
+.import __DATA_LOAD__, __DATA_RUN__, __DATA_SIZE__
+.import __OSCSTACK_SIZE__, __OSCSTACK_START__
+.import _bench
+.importzp sp, ptr1, ptr2
+
+.proc reset
+        sei                     ; disable interrupts
+        cld                     ; clear decimal mode flag
+
+        ldx #$FF                ; initialise stack pointer to $01FF
+        txs
+
+        lda #0                  ; fill zero-page with zeros
+        tax
+@zero:  sta 0,X
+        inx
+        bne @zero
+
+        lda #<__DATA_LOAD__     ; ptr1 = __DATA_LOAD__
+        sta ptr1
+        lda #>__DATA_LOAD__
+        sta ptr1+1
+        lda #<__DATA_RUN__      ; ptr2 = __DATA_RUN__
+        sta ptr2
+        lda #>__DATA_RUN__
+        sta ptr2+1
+
+        ldy #0                  ; copy initialised data to RAM. DATA is
+@copy:  cpy #<__DATA_SIZE__     ; in OSDATA so is less than 256 bytes.
+        beq @copied
+        lda (ptr1),Y
+        sta (ptr2),Y
+        iny
+        bne @copy
+@copied:
+
+                                ; initialise C stack pointer to point to
+                                ; top of stack
+        lda #<(__OSCSTACK_START__ + __OSCSTACK_SIZE__)
+        sta sp
+        lda #>(__OSCSTACK_START__ + __OSCSTACK_SIZE__)
+        sta sp+1
+
+        jmp _bench
+.endproc
+
+; Interrupts are never enabled
+.proc nop_handler
+        rti
+.endproc
+
+.segment "VECTORS"
+
+.word nop_handler       ; (reserved)
+.word nop_handler       ; (reserved)
+.word nop_handler       ; COP
+.word nop_handler       ; (reserved)
+.word nop_handler       ; ABORT
+.word nop_handler       ; NMI
+.word reset             ; RESET
+.word nop_handler       ; IRQ/BRK
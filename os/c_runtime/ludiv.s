@@ -2,12 +2,16 @@
 ; Ullrich von Bassewitz, 17.08.1998
 ;
 ; CC65 runtime: division for long unsigned ints
+;
+; Divisors which fit in 16 bits use the hardware multiply/divide unit.
 ;
 
         .export         tosudiv0ax, tosudiveax, getlop, udiv32
         .import         addysp1
         .importzp       sp, sreg, tmp3, tmp4, ptr1, ptr2, ptr3, ptr4
 
+        .include        "muldiv.inc"
+
 tosudiv0ax:
         ldy     #$00
         sty     sreg
@@ -47,7 +51,40 @@ getlop: sta     ptr3            ; Put right operand in place
 ; Do (ptr1:sreg) / (ptr3:ptr4) --> (ptr1:sreg), remainder in (ptr2:tmp3:tmp4)
 ; This is also the entry point for the signed division
 
-udiv32: lda     #0
+udiv32: lda     ptr4
+        ora     ptr4+1
+        bne     L2              ; Divisor wider than 16 bits
+
+        sta     tmp3            ; Remainder fits in 16 bits
+        sta     tmp4
+        lda     ptr1
+        sta     MULDIV_A
+        lda     ptr1+1
+        sta     MULDIV_A+1
+        lda     sreg
+        sta     MULDIV_A+2
+        lda     sreg+1
+        sta     MULDIV_A+3
+        lda     ptr3
+        sta     MULDIV_B
+        lda     ptr3+1
+        sta     MULDIV_B+1
+
+        lda     MULDIV_QUOTIENT
+        sta     ptr1
+        lda     MULDIV_QUOTIENT+1
+        sta     ptr1+1
+        lda     MULDIV_QUOTIENT+2
+        sta     sreg
+        lda     MULDIV_QUOTIENT+3
+        sta     sreg+1
+        lda     MULDIV_REMAINDER
+        sta     ptr2
+        lda     MULDIV_REMAINDER+1
+        sta     ptr2+1
+        rts
+
+L2:     lda     #0
         sta     ptr2+1
         sta     tmp3
         sta     tmp4
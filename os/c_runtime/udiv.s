@@ -2,12 +2,16 @@
 ; Ullrich von Bassewitz, 07.08.1998
 ;
 ; CC65 runtime: division for unsigned ints
+;
+; Uses the hardware multiply/divide unit.
 ;
 
         .export         tosudiva0, tosudivax, udiv16
         .import         popsreg
         .importzp       sreg, ptr1, ptr4
 
+        .include        "muldiv.inc"
+
 
 tosudiva0:
         ldx     #$00            ; Clear high byte
@@ -27,56 +31,25 @@ tosudivax:
         rts
 
 ;---------------------------------------------------------------------------
-; 16by16 division. Divide sreg by ptr4. Result is in sreg, remainder in ptr1
-; (see mult-div.s from "The Fridge").
+; 16by16 division. Divide sreg by ptr4. Result is in sreg, remainder in ptr1.
 ; This is also the entry point for the signed division
 
-udiv16: lda     #0
-        sta     ptr1+1
-        ldy     #16
-        ldx     ptr4+1
-        beq     udiv16by8a
-
-L0:     asl     sreg
-        rol     sreg+1
-        rol     a
-        rol     ptr1+1
-
-        pha
-        cmp     ptr4
-        lda     ptr1+1
-        sbc     ptr4+1
-        bcc     L1
-
+udiv16: lda     sreg
+        sta     MULDIV_A
+        lda     sreg+1
+        sta     MULDIV_A+1
+        lda     ptr4
+        sta     MULDIV_B
+        lda     ptr4+1
+        sta     MULDIV_B+1
+
+        lda     MULDIV_QUOTIENT
+        sta     sreg
+        lda     MULDIV_QUOTIENT+1
+        sta     sreg+1
+        lda     MULDIV_REMAINDER+1
         sta     ptr1+1
-        pla
-        sbc     ptr4
-        pha
-        inc     sreg
-
-L1:     pla
-        dey
-        bne     L0
-        sta     ptr1
-        rts
-
-
-;---------------------------------------------------------------------------
-; 16by8 division
-
-udiv16by8a:
-@L0:    asl     sreg
-        rol     sreg+1
-        rol     a
-        bcs     @L1
-
-        cmp     ptr4
-        bcc     @L2
-@L1:    sbc     ptr4
-        inc     sreg
-
-@L2:    dey
-        bne     @L0
+        lda     MULDIV_REMAINDER
         sta     ptr1
         rts
 
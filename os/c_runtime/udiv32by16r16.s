@@ -2,11 +2,14 @@
 ; Ullrich von Bassewitz, 2009-11-04
 ;
 ; CC65 runtime: 32by16 => 16 unsigned division
+;
+; Uses the hardware multiply/divide unit.
 ;
 
         .export         udiv32by16r16, udiv32by16r16m
 
         .include        "zeropage.inc"
+        .include        "muldiv.inc"
 
 
 ;---------------------------------------------------------------------------
@@ -23,34 +26,30 @@ udiv32by16r16:
         sta     ptr3
         stx     ptr3+1
 udiv32by16r16m:
-        lda     #0
-        sta     sreg+1
-        ldy     #32
-
-L0:     asl     ptr1
-        rol     ptr1+1
-        rol     ptr2
-        rol     ptr2+1
-        rol     a
-        rol     sreg+1
-
-        pha
-        cmp     ptr3
-        lda     sreg+1
-        sbc     ptr3+1
-        bcc     L1
-
-        sta     sreg+1
-        pla
-        sbc     ptr3
-        pha
-        inc     ptr1
-
-L1:     pla
-        dey
-        bne     L0
-        sta     sreg
         lda     ptr1
-        ldx     ptr1+1
+        sta     MULDIV_A
+        lda     ptr1+1
+        sta     MULDIV_A+1
+        lda     ptr2
+        sta     MULDIV_A+2
+        lda     ptr2+1
+        sta     MULDIV_A+3
+        lda     ptr3
+        sta     MULDIV_B
+        lda     ptr3+1
+        sta     MULDIV_B+1
+
+        lda     MULDIV_REMAINDER
+        sta     sreg
+        lda     MULDIV_REMAINDER+1
+        sta     sreg+1
+        lda     MULDIV_QUOTIENT+2
+        sta     ptr2
+        lda     MULDIV_QUOTIENT+3
+        sta     ptr2+1
+        lda     MULDIV_QUOTIENT
+        ldx     MULDIV_QUOTIENT+1
+        sta     ptr1
+        stx     ptr1+1
         rts
 
@@ -2,12 +2,15 @@
 ; Ullrich von Bassewitz, 2010-11-03
 ;
 ; CC65 runtime: 16x16 => 32 unsigned multiplication
+;
+; Uses the hardware multiply/divide unit.
 ;
 
         .export         umul16x16r32, umul16x16r32m
         .export         umul16x16r16, umul16x16r16m
 
         .include        "zeropage.inc"
+        .include        "muldiv.inc"
 
 
 ;---------------------------------------------------------------------------
@@ -32,32 +35,22 @@ umul16x16r16:
 
 umul16x16r32m:
 umul16x16r16m:
-        lda     #0
-        sta     sreg+1
-        ldy     #16             ; Number of bits
-
-        lsr     ptr1+1
-        ror     ptr1            ; Get first bit into carry
-@L0:    bcc     @L1
-
-        clc
-        adc     ptr3
-        pha
+        lda     ptr3
+        sta     MULDIV_A
         lda     ptr3+1
-        adc     sreg+1
-        sta     sreg+1
-        pla
-
-@L1:    ror     sreg+1
-        ror     a
-        ror     ptr1+1
-        ror     ptr1
-        dey
-        bne     @L0
-
-        sta     sreg            ; Save byte 3
-        lda     ptr1            ; Load the result
-        ldx     ptr1+1
+        sta     MULDIV_A+1
+        lda     ptr1
+        sta     MULDIV_B
+        lda     ptr1+1
+        sta     MULDIV_B+1
+
+        lda     MULDIV_PRODUCT+2
+        sta     sreg            ; Save byte 2
+        lda     MULDIV_PRODUCT+3
+        sta     sreg+1          ; Save byte 3
+        lda     MULDIV_PRODUCT  ; Load the result
+        ldx     MULDIV_PRODUCT+1
+        sta     ptr1
+        stx     ptr1+1
         rts                     ; Done
 
-
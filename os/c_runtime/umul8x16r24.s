@@ -2,12 +2,15 @@
 ; Ullrich von Bassewitz, 2011-07-10
 ;
 ; CC65 runtime: 8x16 => 24 unsigned multiplication
+;
+; Uses the hardware multiply/divide unit.
 ;
 
         .export         umul8x16r24, umul8x16r24m
         .export         umul8x16r16, umul8x16r16m
 
         .include        "zeropage.inc"
+        .include        "muldiv.inc"
 
 
 ;---------------------------------------------------------------------------
@@ -30,34 +33,18 @@ umul8x16r16:
 
 umul8x16r24m:
 umul8x16r16m:
-        ldx     #0
-        stx     ptr1+1
-        stx     sreg
-
-        ldy     #8              ; Number of bits
-        ldx     ptr3            ; Get into register for speed
-        lda     ptr1
-        ror     a               ; Get next bit into carry
-@L0:    bcc     @L1
-
-        clc
-        pha
-        txa
-        adc     ptr1+1
-        sta     ptr1+1
+        lda     ptr3
+        sta     MULDIV_A
         lda     ptr3+1
-        adc     sreg
-        sta     sreg
-        pla
-
-@L1:    ror     sreg
-        ror     ptr1+1
-        ror     a
-        dey
-        bne     @L0
+        sta     MULDIV_A+1
+        lda     ptr1
+        sta     MULDIV_B        ; Clears the high byte
 
+        lda     MULDIV_PRODUCT+2
+        sta     sreg            ; Save byte 2
+        lda     MULDIV_PRODUCT  ; Load the result
+        ldx     MULDIV_PRODUCT+1
         sta     ptr1            ; Save low byte of result
-        ldx     ptr1+1          ; Load high byte of result
+        stx     ptr1+1
         rts                     ; Done
 
-
@@ -2,11 +2,15 @@
 ; Ullrich von Bassewitz, 2010-11-02
 ;
 ; CC65 runtime: 8x8 => 16 unsigned multiplication
+;
+; Uses the hardware multiply/divide unit.
 ;
 
         .export         umul8x8r16, umul8x8r16m
         .importzp       ptr1, ptr3
 
+        .include        "muldiv.inc"
+
 
 ;---------------------------------------------------------------------------
 ; 8x8 => 16 unsigned multiplication routine.
@@ -19,17 +23,13 @@
 umul8x8r16:
         sta     ptr3
 umul8x8r16m:
-        lda     #0              ; Clear byte 1
-        ldy     #8              ; Number of bits
-        lsr     ptr1            ; Get first bit of RHS into carry
-@L0:    bcc     @L1
-        clc
-        adc     ptr3
-@L1:    ror
-        ror     ptr1
-        dey
-        bne     @L0
-        tax
+        lda     ptr3
+        sta     MULDIV_A        ; Clears the high bytes
+        lda     ptr1
+        sta     MULDIV_B
+
+        ldx     MULDIV_PRODUCT+1
         stx     ptr1+1          ; Result in .XA and ptr1
-        lda     ptr1            ; Load the result
+        lda     MULDIV_PRODUCT  ; Load the result
+        sta     ptr1
         rts                     ; Done
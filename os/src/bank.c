@@ -0,0 +1,34 @@
+#include "types.h"
+#include "bank.h"
+
+u8 ram_bank_select(u8 bank) {
+    u8 previous = RAM_BANK;
+    RAM_BANK = bank;
+    return previous;
+}
+
+void ram_bank_read(void *dst, u8 bank, u16 offset, u16 len) {
+    u8 *d = (u8*)dst;
+    const u8 *s = RAM_BANK_WINDOW + offset;
+    u8 previous = ram_bank_select(bank);
+
+    while(len) {
+        *d++ = *s++;
+        --len;
+    }
+
+    RAM_BANK = previous;
+}
+
+void ram_bank_write(u8 bank, u16 offset, const void *src, u16 len) {
+    const u8 *s = (const u8*)src;
+    u8 *d = RAM_BANK_WINDOW + offset;
+    u8 previous = ram_bank_select(bank);
+
+    while(len) {
+        *d++ = *s++;
+        --len;
+    }
+
+    RAM_BANK = previous;
+}
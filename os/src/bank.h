@@ -0,0 +1,22 @@
+#ifndef BANK_H__
+#define BANK_H__
+
+#include "types.h"
+
+// Four 8K banks of RAM are visible one at a time in the window at $A000.
+// Data can be placed in the window with #pragma bss-name("BANKED").
+#define RAM_BANK (*((volatile u8*)0x8401))
+#define RAM_BANK_WINDOW ((u8*)0xA000)
+#define RAM_BANK_SIZE 0x2000
+#define RAM_BANK_COUNT 4
+
+// Make a bank visible in the window, returning the previously visible bank so
+// that it can be restored.
+u8 ram_bank_select(u8 bank);
+
+// Copy between normal memory and an offset within a bank. The copy must not
+// run past the end of the bank. The visible bank is preserved.
+void ram_bank_read(void *dst, u8 bank, u16 offset, u16 len);
+void ram_bank_write(u8 bank, u16 offset, const void *src, u16 len);
+
+#endif // BANK_H__
@@ -0,0 +1,221 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bank.h"
+#include "console.h"
+#include "types.h"
+#include "vdp.h"
+
+// The shadow tables are laid out as in VRAM. Rows are physical rows; the
+// logical top row is at row top once the screen has scrolled. Each row records
+// the range of columns [dirty_first, dirty_last) changed since the last flush.
+#define CONSOLE_CELLS (CONSOLE_MAX_WIDTH * CONSOLE_MAX_HEIGHT)
+
+#pragma bss-name(push, "BANKED")
+static u8 shadow_names[CONSOLE_CELLS];
+static u8 shadow_attrs[CONSOLE_CELLS];
+static u16 row_offset[CONSOLE_MAX_HEIGHT];
+static u8 dirty_first[CONSOLE_MAX_HEIGHT];
+static u8 dirty_last[CONSOLE_MAX_HEIGHT];
+static char format_buffer[128];
+#pragma bss-name(pop)
+
+static u8 width, height, top;
+static u8 cursor_x, cursor_y, color;
+static u16 name_base, attr_base;
+static u8 scroll_pending;
+
+static void mark_row(u8 row, u8 first, u8 last) {
+    if(first < dirty_first[row]) {
+        dirty_first[row] = first;
+    }
+    if(last > dirty_last[row]) {
+        dirty_last[row] = last;
+    }
+}
+
+static void clear_row(u8 row) {
+    memset(&shadow_names[row_offset[row]], ' ', width);
+    memset(&shadow_attrs[row_offset[row]], color, width);
+    mark_row(row, 0, width);
+}
+
+// The old top row becomes the new bottom row. The scroll registers are
+// written by the next flush, with the cleared row, so that both change
+// together.
+static void scroll_up(void) {
+    u8 row = top;
+
+    if(++top == height) {
+        top = 0;
+    }
+    clear_row(row);
+    scroll_pending = 1;
+}
+
+static void newline(void) {
+    cursor_x = 0;
+    if(cursor_y + 1 < height) {
+        ++cursor_y;
+    } else {
+        scroll_up();
+    }
+}
+
+// Write one character. The console bank must be selected.
+static void put(char c) {
+    u8 row;
+    u16 offset;
+
+    switch(c) {
+        case '\n':
+            newline();
+            return;
+        case '\r':
+            cursor_x = 0;
+            return;
+        case '\b':
+            if(cursor_x > 0) {
+                --cursor_x;
+            }
+            return;
+    }
+
+    row = cursor_y + top;
+    if(row >= height) {
+        row -= height;
+    }
+    offset = row_offset[row] + cursor_x;
+    shadow_names[offset] = c;
+    shadow_attrs[offset] = color;
+    mark_row(row, cursor_x, cursor_x + 1);
+
+    if(++cursor_x == width) {
+        newline();
+    }
+}
+
+void console_init(u8 w, u8 h, u16 names, u16 attrs, u8 attr) {
+    u8 bank = ram_bank_select(CONSOLE_BANK);
+    u8 row;
+    u16 offset = 0;
+
+    width = w;
+    height = h;
+    name_base = names;
+    attr_base = attrs;
+    color = attr;
+
+    for(row=0; row<height; ++row) {
+        row_offset[row] = offset;
+        offset += width;
+    }
+
+    RAM_BANK = bank;
+
+    console_clear();
+}
+
+void console_clear(void) {
+    u8 bank = ram_bank_select(CONSOLE_BANK);
+    u8 row;
+
+    top = 0;
+    scroll_pending = 1;
+    for(row=0; row<height; ++row) {
+        dirty_first[row] = 0xff;
+        dirty_last[row] = 0;
+        clear_row(row);
+    }
+    cursor_x = 0;
+    cursor_y = 0;
+
+    RAM_BANK = bank;
+}
+
+void console_goto(u8 x, u8 y) {
+    cursor_x = x;
+    cursor_y = y;
+}
+
+void console_color(u8 attr) {
+    color = attr;
+}
+
+void console_putc(char c) {
+    u8 bank = ram_bank_select(CONSOLE_BANK);
+    put(c);
+    RAM_BANK = bank;
+}
+
+void console_puts(const char *s) {
+    u8 bank = ram_bank_select(CONSOLE_BANK);
+    for(; *s; ++s) {
+        put(*s);
+    }
+    RAM_BANK = bank;
+}
+
+// The format buffer is in the console bank, so the format and arguments must
+// not be in banked RAM.
+void console_printf(const char *format, ...) {
+    u8 bank = ram_bank_select(CONSOLE_BANK);
+    char *s = format_buffer;
+    va_list args;
+
+    va_start(args, format);
+    vsnprintf(format_buffer, sizeof(format_buffer), format, args);
+    va_end(args);
+
+    for(; *s; ++s) {
+        put(*s);
+    }
+    RAM_BANK = bank;
+}
+
+void console_scroll(void) {
+    u8 bank = ram_bank_select(CONSOLE_BANK);
+    scroll_up();
+    RAM_BANK = bank;
+}
+
+u8 console_top(void) {
+    return top;
+}
+
+// Copy the changed ranges to VRAM. A range which starts where the previous
+// one ended, such as a run of whole rows, is copied along with it.
+void console_flush(void) {
+    u8 bank = ram_bank_select(CONSOLE_BANK);
+    u8 row;
+    u16 start = 0, end = 0;
+    u16 row_start, row_end;
+
+    if(scroll_pending) {
+        vdp_scroll(0, top << 4);
+        scroll_pending = 0;
+    }
+
+    for(row=0; row<height; ++row) {
+        if(dirty_last[row] == 0) {
+            continue;
+        }
+
+        row_start = row_offset[row] + dirty_first[row];
+        row_end = row_offset[row] + dirty_last[row];
+        dirty_first[row] = 0xff;
+        dirty_last[row] = 0;
+
+        if(row_start != end) {
+            vdp_upload(&shadow_names[start], name_base + start, end - start);
+            vdp_upload(&shadow_attrs[start], attr_base + start, end - start);
+            start = row_start;
+        }
+        end = row_end;
+    }
+    vdp_upload(&shadow_names[start], name_base + start, end - start);
+    vdp_upload(&shadow_attrs[start], attr_base + start, end - start);
+
+    RAM_BANK = bank;
+}
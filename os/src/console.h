@@ -0,0 +1,46 @@
+#ifndef CONSOLE_H__
+#define CONSOLE_H__
+
+#include "types.h"
+
+// Text console. Output goes to a shadow of the name and attribute tables in
+// banked RAM. console_flush() copies the changed part of each line to VRAM,
+// merging lines which run into each other into a single copy. Flushing just
+// after vdp_wait_vblank() avoids tearing.
+#define CONSOLE_MAX_WIDTH       106
+#define CONSOLE_MAX_HEIGHT      30
+
+// RAM bank holding the shadow tables. The console selects it while it runs
+// and restores the previous bank afterwards.
+#define CONSOLE_BANK            0
+
+// Set up the console for a screen and its tables in VRAM. The screen is
+// cleared to attr on the next flush.
+void console_init(u8 width, u8 height, u16 name_base, u16 attr_base, u8 attr);
+
+// Clear the screen to the current colour and move the cursor home.
+void console_clear(void);
+
+void console_goto(u8 x, u8 y);
+void console_color(u8 attr);
+
+// Write characters at the cursor in the current colour. '\n' starts a new
+// line, '\r' returns to the start of the line and '\b' moves back. Writing
+// past the bottom line scrolls the screen up.
+void console_putc(char c);
+void console_puts(const char *s);
+void console_printf(const char *format, ...);
+
+// Scroll the screen up a line using the VDP scroll registers. The new bottom
+// line is cleared to the current colour.
+void console_scroll(void);
+
+// Copy changes to VRAM.
+void console_flush(void);
+
+// Row of the name and attribute tables shown at the top of the screen once
+// the console has scrolled. Code writing to VRAM directly adds it to screen
+// rows, wrapping at the screen height.
+u8 console_top(void);
+
+#endif // CONSOLE_H__
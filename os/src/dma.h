@@ -0,0 +1,24 @@
+#ifndef DMA_H__
+#define DMA_H__
+
+#include "types.h"
+
+// DMA controller. A transfer copies a block from the CPU address space into
+// VRAM, holding the CPU until it completes. The controller sets the VDP write
+// address by selecting VDP registers 2 and 3, so afterwards VDP register 3 is
+// selected and the write address is the destination plus the length.
+#define DMA_SRC_L (*((volatile u8*)0x8410))
+#define DMA_SRC_H (*((volatile u8*)0x8411))
+#define DMA_DST_L (*((volatile u8*)0x8412))
+#define DMA_DST_H (*((volatile u8*)0x8413))
+#define DMA_LEN_L (*((volatile u8*)0x8414))
+#define DMA_LEN_H (*((volatile u8*)0x8415))
+#define DMA_CONTROL (*((volatile u8*)0x8416))
+
+// Bits in DMA_CONTROL. DMA_DONE is acknowledged by writing a 1 to it.
+#define DMA_START               0x01
+#define DMA_IRQ_ENABLE          0x02
+#define DMA_DONE                0x40
+#define DMA_BUSY                0x80
+
+#endif // DMA_H__
@@ -1,174 +0,0 @@
-const unsigned char font_bin[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7e, 0x81, 0xa5, 0x81,
-  0xbd, 0x99, 0x42, 0x3c, 0x7e, 0xff, 0xdb, 0xff, 0xc3, 0xe7, 0x7e, 0x3c,
-  0x36, 0x7f, 0x7f, 0x7f, 0x3e, 0x1c, 0x08, 0x00, 0x08, 0x1c, 0x3e, 0x7f,
-  0x3e, 0x1c, 0x08, 0x00, 0x1c, 0x3e, 0x1c, 0x7f, 0x7f, 0x6b, 0x08, 0x1c,
-  0x08, 0x08, 0x1c, 0x3e, 0x7f, 0x3e, 0x08, 0x1c, 0x00, 0x00, 0x18, 0x3c,
-  0x3c, 0x18, 0x00, 0x00, 0xff, 0xff, 0xe7, 0xc3, 0xc3, 0xe7, 0xff, 0xff,
-  0x00, 0x3c, 0x66, 0x42, 0x42, 0x66, 0x3c, 0x00, 0xff, 0xc3, 0x99, 0xbd,
-  0xbd, 0x99, 0xc3, 0xff, 0x0f, 0x07, 0x0f, 0x7d, 0xcc, 0xcc, 0xcc, 0x78,
-  0x3c, 0x66, 0x66, 0x66, 0x3c, 0x18, 0x7e, 0x18, 0x08, 0x0c, 0x0e, 0x0a,
-  0x0a, 0x38, 0x78, 0x30, 0x00, 0x3e, 0x22, 0x22, 0x26, 0x6e, 0xe4, 0x40,
-  0x18, 0xdb, 0x3c, 0xe7, 0xe7, 0x3c, 0xdb, 0x18, 0x20, 0x30, 0x38, 0x3c,
-  0x38, 0x30, 0x20, 0x00, 0x04, 0x0c, 0x1c, 0x3c, 0x1c, 0x0c, 0x04, 0x00,
-  0x18, 0x3c, 0x7e, 0x18, 0x18, 0x7e, 0x3c, 0x18, 0x66, 0x66, 0x66, 0x66,
-  0x66, 0x00, 0x66, 0x00, 0x7f, 0xdb, 0xdb, 0x7b, 0x1b, 0x1b, 0x1b, 0x00,
-  0x3c, 0x60, 0x3c, 0x66, 0x3c, 0x06, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x7e, 0x7e, 0x00, 0x00, 0x18, 0x3c, 0x7e, 0x18, 0x7e, 0x3c, 0x18, 0xff,
-  0x18, 0x3c, 0x7e, 0x18, 0x18, 0x18, 0x18, 0x00, 0x18, 0x18, 0x18, 0x18,
-  0x7e, 0x3c, 0x18, 0x00, 0x00, 0x0c, 0x06, 0x7f, 0x06, 0x0c, 0x00, 0x00,
-  0x00, 0x18, 0x30, 0x7f, 0x30, 0x18, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60,
-  0x60, 0x7e, 0x00, 0x00, 0x00, 0x24, 0x66, 0xff, 0x66, 0x24, 0x00, 0x00,
-  0x00, 0x08, 0x1c, 0x3e, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0x3e,
-  0x1c, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x18, 0x3c, 0x3c, 0x18, 0x18, 0x00, 0x18, 0x00, 0x36, 0x36, 0x36, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x36, 0x36, 0x7f, 0x36, 0x7f, 0x36, 0x36, 0x00,
-  0x18, 0x3e, 0x60, 0x3c, 0x06, 0x7c, 0x18, 0x00, 0x60, 0x66, 0x0c, 0x18,
-  0x30, 0x66, 0x06, 0x00, 0x38, 0x66, 0x66, 0x3f, 0x66, 0x66, 0x3b, 0x00,
-  0x1c, 0x18, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x18, 0x30, 0x30,
-  0x30, 0x18, 0x0c, 0x00, 0x30, 0x18, 0x0c, 0x0c, 0x0c, 0x18, 0x30, 0x00,
-  0x00, 0x66, 0x3c, 0xff, 0x3c, 0x66, 0x00, 0x00, 0x00, 0x18, 0x18, 0x7e,
-  0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x30,
-  0x00, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x18, 0x18, 0x00, 0x00, 0x06, 0x0c, 0x18, 0x30, 0x60, 0x00, 0x00,
-  0x3c, 0x66, 0x6e, 0x7e, 0x76, 0x66, 0x3c, 0x00, 0x18, 0x38, 0x18, 0x18,
-  0x18, 0x18, 0x7e, 0x00, 0x3c, 0x66, 0x06, 0x1c, 0x30, 0x66, 0x7e, 0x00,
-  0x3c, 0x66, 0x06, 0x1c, 0x06, 0x66, 0x3c, 0x00, 0x0e, 0x1e, 0x36, 0x66,
-  0x7f, 0x06, 0x0f, 0x00, 0x7e, 0x60, 0x60, 0x7c, 0x06, 0x66, 0x3c, 0x00,
-  0x1c, 0x30, 0x60, 0x7c, 0x66, 0x66, 0x3c, 0x00, 0x7e, 0x66, 0x06, 0x0c,
-  0x18, 0x18, 0x18, 0x00, 0x3c, 0x66, 0x66, 0x3c, 0x66, 0x66, 0x3c, 0x00,
-  0x3c, 0x66, 0x66, 0x3e, 0x06, 0x0c, 0x38, 0x00, 0x00, 0x00, 0x18, 0x18,
-  0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x18, 0x18, 0x30,
-  0x0c, 0x18, 0x30, 0x60, 0x30, 0x18, 0x0c, 0x00, 0x00, 0x00, 0x7e, 0x00,
-  0x7e, 0x00, 0x00, 0x00, 0x30, 0x18, 0x0c, 0x06, 0x0c, 0x18, 0x30, 0x00,
-  0x3c, 0x66, 0x06, 0x0c, 0x18, 0x00, 0x18, 0x00, 0x3c, 0x66, 0x6e, 0x6a,
-  0x6e, 0x60, 0x3c, 0x00, 0x3c, 0x66, 0x66, 0x7e, 0x66, 0x66, 0x66, 0x00,
-  0x7c, 0x66, 0x66, 0x7c, 0x66, 0x66, 0x7c, 0x00, 0x3c, 0x66, 0x60, 0x60,
-  0x60, 0x66, 0x3c, 0x00, 0x78, 0x6c, 0x66, 0x66, 0x66, 0x6c, 0x78, 0x00,
-  0x7e, 0x60, 0x60, 0x7c, 0x60, 0x60, 0x7e, 0x00, 0x7e, 0x60, 0x60, 0x7c,
-  0x60, 0x60, 0x60, 0x00, 0x3c, 0x66, 0x60, 0x6e, 0x66, 0x66, 0x3c, 0x00,
-  0x66, 0x66, 0x66, 0x7e, 0x66, 0x66, 0x66, 0x00, 0x3c, 0x18, 0x18, 0x18,
-  0x18, 0x18, 0x3c, 0x00, 0x0e, 0x06, 0x06, 0x06, 0x66, 0x66, 0x3c, 0x00,
-  0x66, 0x66, 0x6c, 0x78, 0x6c, 0x66, 0x66, 0x00, 0x60, 0x60, 0x60, 0x60,
-  0x60, 0x60, 0x7e, 0x00, 0x63, 0x77, 0x7f, 0x7f, 0x6b, 0x63, 0x63, 0x00,
-  0x66, 0x76, 0x7e, 0x7e, 0x6e, 0x66, 0x66, 0x00, 0x3c, 0x66, 0x66, 0x66,
-  0x66, 0x66, 0x3c, 0x00, 0x7c, 0x66, 0x66, 0x7c, 0x60, 0x60, 0x60, 0x00,
-  0x3c, 0x66, 0x66, 0x66, 0x6e, 0x3c, 0x0e, 0x00, 0x7c, 0x66, 0x66, 0x7c,
-  0x6c, 0x66, 0x66, 0x00, 0x3c, 0x66, 0x60, 0x3c, 0x06, 0x66, 0x3c, 0x00,
-  0x7e, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00, 0x66, 0x66, 0x66, 0x66,
-  0x66, 0x66, 0x3c, 0x00, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3c, 0x18, 0x00,
-  0x63, 0x63, 0x63, 0x6b, 0x7f, 0x77, 0x63, 0x00, 0x66, 0x66, 0x3c, 0x18,
-  0x3c, 0x66, 0x66, 0x00, 0x66, 0x66, 0x66, 0x3c, 0x18, 0x18, 0x18, 0x00,
-  0x7e, 0x06, 0x0c, 0x18, 0x30, 0x60, 0x7e, 0x00, 0x3e, 0x30, 0x30, 0x30,
-  0x30, 0x30, 0x3e, 0x00, 0x00, 0x60, 0x30, 0x18, 0x0c, 0x06, 0x00, 0x00,
-  0x3e, 0x06, 0x06, 0x06, 0x06, 0x06, 0x3e, 0x00, 0x08, 0x1c, 0x36, 0x63,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00,
-  0x38, 0x18, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3c, 0x06,
-  0x3e, 0x66, 0x3e, 0x00, 0x60, 0x60, 0x7c, 0x66, 0x66, 0x66, 0x7c, 0x00,
-  0x00, 0x00, 0x3c, 0x66, 0x60, 0x66, 0x3c, 0x00, 0x06, 0x06, 0x3e, 0x66,
-  0x66, 0x66, 0x3e, 0x00, 0x00, 0x00, 0x3c, 0x66, 0x7e, 0x60, 0x3c, 0x00,
-  0x1e, 0x30, 0x30, 0x7c, 0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x3e, 0x66,
-  0x66, 0x3e, 0x06, 0x3c, 0x60, 0x60, 0x7c, 0x66, 0x66, 0x66, 0x66, 0x00,
-  0x18, 0x00, 0x38, 0x18, 0x18, 0x18, 0x3c, 0x00, 0x18, 0x00, 0x38, 0x18,
-  0x18, 0x18, 0x18, 0x30, 0x60, 0x60, 0x66, 0x6c, 0x78, 0x6c, 0x66, 0x00,
-  0x38, 0x18, 0x18, 0x18, 0x18, 0x18, 0x0c, 0x00, 0x00, 0x00, 0x36, 0x7f,
-  0x6b, 0x6b, 0x63, 0x00, 0x00, 0x00, 0x7c, 0x66, 0x66, 0x66, 0x66, 0x00,
-  0x00, 0x00, 0x3c, 0x66, 0x66, 0x66, 0x3c, 0x00, 0x00, 0x00, 0x7c, 0x66,
-  0x66, 0x7c, 0x60, 0x60, 0x00, 0x00, 0x3e, 0x66, 0x66, 0x3e, 0x06, 0x07,
-  0x00, 0x00, 0x7c, 0x66, 0x60, 0x60, 0x60, 0x00, 0x00, 0x00, 0x3e, 0x60,
-  0x3c, 0x06, 0x7c, 0x00, 0x30, 0x30, 0x7c, 0x30, 0x30, 0x30, 0x1c, 0x00,
-  0x00, 0x00, 0x66, 0x66, 0x66, 0x66, 0x3e, 0x00, 0x00, 0x00, 0x66, 0x66,
-  0x66, 0x3c, 0x18, 0x00, 0x00, 0x00, 0x63, 0x6b, 0x6b, 0x7f, 0x36, 0x00,
-  0x00, 0x00, 0x66, 0x3c, 0x18, 0x3c, 0x66, 0x00, 0x00, 0x00, 0x66, 0x66,
-  0x66, 0x3e, 0x06, 0x3c, 0x00, 0x00, 0x7e, 0x0c, 0x18, 0x30, 0x7e, 0x00,
-  0x1c, 0x30, 0x30, 0x60, 0x30, 0x30, 0x1c, 0x00, 0x18, 0x18, 0x18, 0x00,
-  0x18, 0x18, 0x18, 0x00, 0x38, 0x0c, 0x0c, 0x06, 0x0c, 0x0c, 0x38, 0x00,
-  0x00, 0x00, 0x3b, 0x6e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x1c, 0x36,
-  0x63, 0x63, 0x7f, 0x00, 0x3c, 0x66, 0x60, 0x60, 0x60, 0x66, 0x3c, 0x60,
-  0x66, 0x00, 0x66, 0x66, 0x66, 0x66, 0x3e, 0x00, 0x0c, 0x18, 0x3c, 0x66,
-  0x7e, 0x60, 0x3c, 0x00, 0x7e, 0xc3, 0x3c, 0x06, 0x3e, 0x66, 0x3e, 0x00,
-  0x66, 0x00, 0x3c, 0x06, 0x3e, 0x66, 0x3e, 0x00, 0x30, 0x18, 0x3c, 0x06,
-  0x3e, 0x66, 0x3e, 0x00, 0x18, 0x24, 0x3c, 0x06, 0x3e, 0x66, 0x3e, 0x00,
-  0x00, 0x00, 0x3c, 0x66, 0x60, 0x66, 0x3c, 0x60, 0x7e, 0xc3, 0x3c, 0x66,
-  0x7e, 0x60, 0x3c, 0x00, 0x66, 0x00, 0x3c, 0x66, 0x7e, 0x60, 0x3c, 0x00,
-  0x30, 0x18, 0x3c, 0x66, 0x7e, 0x60, 0x3c, 0x00, 0x66, 0x00, 0x38, 0x18,
-  0x18, 0x18, 0x3c, 0x00, 0x3c, 0x66, 0x00, 0x38, 0x18, 0x18, 0x3c, 0x00,
-  0x30, 0x18, 0x00, 0x38, 0x18, 0x18, 0x3c, 0x00, 0x66, 0x00, 0x3c, 0x66,
-  0x7e, 0x66, 0x66, 0x00, 0x18, 0x24, 0x3c, 0x66, 0x7e, 0x66, 0x66, 0x00,
-  0x0c, 0x18, 0x7e, 0x60, 0x7c, 0x60, 0x7e, 0x00, 0x00, 0x00, 0x7e, 0x1b,
-  0x7f, 0xd8, 0x7e, 0x00, 0x1f, 0x3c, 0x6c, 0x7f, 0x6c, 0x6c, 0x6f, 0x00,
-  0x3c, 0x66, 0x00, 0x3c, 0x66, 0x66, 0x3c, 0x00, 0x00, 0x66, 0x00, 0x3c,
-  0x66, 0x66, 0x3c, 0x00, 0x30, 0x18, 0x00, 0x3c, 0x66, 0x66, 0x3c, 0x00,
-  0x3c, 0x66, 0x00, 0x66, 0x66, 0x66, 0x3e, 0x00, 0x30, 0x18, 0x00, 0x66,
-  0x66, 0x66, 0x3e, 0x00, 0x66, 0x00, 0x66, 0x66, 0x66, 0x3e, 0x06, 0x3c,
-  0x66, 0x3c, 0x66, 0x66, 0x66, 0x66, 0x3c, 0x00, 0x66, 0x00, 0x66, 0x66,
-  0x66, 0x66, 0x3c, 0x00, 0x00, 0x0c, 0x1e, 0x30, 0x30, 0x1e, 0x0c, 0x00,
-  0x1c, 0x36, 0x30, 0x7c, 0x30, 0x60, 0x7e, 0x00, 0x66, 0x66, 0x3c, 0x7e,
-  0x18, 0x7e, 0x18, 0x00, 0x7c, 0x66, 0x6e, 0x7c, 0x6e, 0x6c, 0x66, 0x00,
-  0x0e, 0x18, 0x18, 0x3c, 0x18, 0x18, 0x70, 0x00, 0x0c, 0x18, 0x3c, 0x06,
-  0x3e, 0x66, 0x3e, 0x00, 0x0c, 0x18, 0x00, 0x38, 0x18, 0x18, 0x3c, 0x00,
-  0x0c, 0x18, 0x00, 0x3c, 0x66, 0x66, 0x3c, 0x00, 0x0c, 0x18, 0x00, 0x66,
-  0x66, 0x66, 0x3e, 0x00, 0x36, 0x6c, 0x00, 0x7c, 0x66, 0x66, 0x66, 0x00,
-  0x36, 0x6c, 0x00, 0x66, 0x76, 0x6e, 0x66, 0x00, 0x38, 0x0c, 0x3c, 0x6c,
-  0x3c, 0x00, 0x00, 0x00, 0x38, 0x6c, 0x6c, 0x6c, 0x38, 0x00, 0x00, 0x00,
-  0x18, 0x00, 0x18, 0x30, 0x60, 0x66, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x7e,
-  0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7e, 0x06, 0x06, 0x00, 0x00,
-  0x40, 0x42, 0x44, 0x48, 0x16, 0x23, 0x46, 0x07, 0x40, 0x42, 0x44, 0x48,
-  0x15, 0x25, 0x47, 0x01, 0x18, 0x00, 0x18, 0x18, 0x3c, 0x3c, 0x18, 0x00,
-  0x00, 0x36, 0x6c, 0xd8, 0x6c, 0x36, 0x00, 0x00, 0x00, 0x6c, 0x36, 0x1b,
-  0x36, 0x6c, 0x00, 0x00, 0x22, 0x88, 0x22, 0x88, 0x22, 0x88, 0x22, 0x88,
-  0x55, 0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55, 0xaa, 0xbb, 0xee, 0xbb, 0xee,
-  0xbb, 0xee, 0xbb, 0xee, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
-  0x18, 0x18, 0x18, 0xf8, 0xf8, 0x18, 0x18, 0x18, 0x18, 0xf8, 0xf8, 0x18,
-  0x18, 0xf8, 0xf8, 0x18, 0x66, 0x66, 0x66, 0xe6, 0xe6, 0x66, 0x66, 0x66,
-  0x00, 0x00, 0x00, 0xfe, 0xfe, 0x66, 0x66, 0x66, 0x00, 0xf8, 0xf8, 0x18,
-  0x18, 0xf8, 0xf8, 0x18, 0x66, 0xe6, 0xe6, 0x06, 0x06, 0xe6, 0xe6, 0x66,
-  0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x00, 0xfe, 0xfe, 0x06,
-  0x06, 0xe6, 0xe6, 0x66, 0x66, 0xe6, 0xe6, 0x06, 0x06, 0xfe, 0xfe, 0x00,
-  0x66, 0x66, 0x66, 0xfe, 0xfe, 0x00, 0x00, 0x00, 0x10, 0xf8, 0xf8, 0x18,
-  0x18, 0xf8, 0xf8, 0x00, 0x00, 0x00, 0x00, 0xf8, 0xf8, 0x18, 0x18, 0x18,
-  0x18, 0x18, 0x18, 0x1f, 0x1f, 0x00, 0x00, 0x00, 0x18, 0x18, 0x18, 0xff,
-  0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x18, 0x18, 0x18,
-  0x18, 0x18, 0x18, 0x1f, 0x1f, 0x18, 0x18, 0x18, 0x00, 0x00, 0x00, 0xff,
-  0xff, 0x00, 0x00, 0x00, 0x18, 0x18, 0x18, 0xff, 0xff, 0x18, 0x18, 0x18,
-  0x18, 0x1f, 0x1f, 0x18, 0x18, 0x1f, 0x1f, 0x18, 0x66, 0x66, 0x66, 0x67,
-  0x67, 0x66, 0x66, 0x66, 0x66, 0x67, 0x67, 0x60, 0x60, 0x7f, 0x7f, 0x00,
-  0x00, 0x7f, 0x7f, 0x60, 0x60, 0x67, 0x67, 0x66, 0x66, 0xe7, 0xe7, 0x00,
-  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0xe7, 0xe7, 0x66,
-  0x66, 0x67, 0x67, 0x60, 0x60, 0x67, 0x67, 0x66, 0x00, 0xff, 0xff, 0x00,
-  0x00, 0xff, 0xff, 0x00, 0x66, 0xe7, 0xe7, 0x00, 0x00, 0xe7, 0xe7, 0x66,
-  0x18, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00, 0x66, 0x66, 0x66, 0xff,
-  0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x18,
-  0x00, 0x00, 0x00, 0xff, 0xff, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x7f,
-  0x7f, 0x00, 0x00, 0x00, 0x18, 0x1f, 0x1f, 0x18, 0x18, 0x1f, 0x1f, 0x00,
-  0x00, 0x1f, 0x1f, 0x18, 0x18, 0x1f, 0x1f, 0x18, 0x00, 0x00, 0x00, 0x7f,
-  0x7f, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0xe7, 0xe7, 0x66, 0x66, 0x66,
-  0x18, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x18, 0x18, 0x18, 0x18, 0xf8,
-  0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x1f, 0x18, 0x18, 0x18,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
-  0xff, 0xff, 0xff, 0xff, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
-  0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0xff, 0xff, 0xff, 0xff,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3b, 0x6e, 0x64, 0x6e, 0x3b, 0x00,
-  0x3c, 0x66, 0x66, 0x6c, 0x66, 0x63, 0x6e, 0x60, 0x7e, 0x66, 0x60, 0x60,
-  0x60, 0x60, 0x60, 0x00, 0x00, 0x7f, 0x36, 0x36, 0x36, 0x36, 0x36, 0x00,
-  0x7e, 0x60, 0x30, 0x18, 0x30, 0x60, 0x7e, 0x00, 0x00, 0x00, 0x3e, 0x78,
-  0x6c, 0x6c, 0x38, 0x00, 0x00, 0x00, 0x66, 0x66, 0x6e, 0x7b, 0x60, 0x60,
-  0x00, 0x00, 0x7e, 0x18, 0x18, 0x18, 0x0c, 0x00, 0x3c, 0x18, 0x3c, 0x66,
-  0x66, 0x3c, 0x18, 0x3c, 0x3c, 0x66, 0x66, 0x7e, 0x66, 0x66, 0x3c, 0x00,
-  0x3e, 0x63, 0x63, 0x63, 0x63, 0x36, 0x77, 0x00, 0x3c, 0x30, 0x18, 0x3c,
-  0x66, 0x66, 0x3c, 0x00, 0x00, 0x00, 0x36, 0x6f, 0x6b, 0x7b, 0x36, 0x00,
-  0x00, 0x03, 0x3e, 0x66, 0x7e, 0x66, 0x7c, 0xc0, 0x00, 0x00, 0x3e, 0x60,
-  0x3c, 0x60, 0x3e, 0x00, 0x3c, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x00,
-  0x00, 0x7e, 0x00, 0x7e, 0x00, 0x7e, 0x00, 0x00, 0x18, 0x18, 0x7e, 0x18,
-  0x18, 0x00, 0x7e, 0x00, 0x30, 0x18, 0x0c, 0x18, 0x30, 0x00, 0x7e, 0x00,
-  0x0c, 0x18, 0x30, 0x18, 0x0c, 0x00, 0x7e, 0x00, 0x0e, 0x1b, 0x1b, 0x18,
-  0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0xd8, 0xd8, 0x70,
-  0x00, 0x18, 0x00, 0x7e, 0x00, 0x18, 0x00, 0x00, 0x00, 0x3b, 0x6e, 0x00,
-  0x3b, 0x6e, 0x00, 0x00, 0x1c, 0x36, 0x36, 0x1c, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x18, 0x00, 0x00, 0x00, 0x0f, 0x0c, 0x0c, 0xcc, 0x6c, 0x3c, 0x1c, 0x0c,
-  0x3c, 0x36, 0x36, 0x36, 0x36, 0x00, 0x00, 0x00, 0x38, 0x0c, 0x18, 0x30,
-  0x3c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3c, 0x3c, 0x3c, 0x3c, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-unsigned int font_bin_len = 2048;
@@ -1,6 +1,9 @@
+#include "console.h"
 #include "interrupt.h"
+#include "perf.h"
 #include "types.h"
-#include "font.h"
+#include "uart.h"
+#include "vdp.h"
 
 // Defined by linker
 extern u8 *_DATA_RUN__, *_DATA_LOAD__;
@@ -9,8 +12,8 @@ extern u16 _DATA_SIZE__;
 int rand();
 void srand (unsigned seed);
 
-// Entry point for OS. When called interrupts are disabled, zero-page is
-// initialised to zero and the stack pointer is set up.
+// Entry point for OS. When called interrupts are disabled, zero-page and BSS
+// are initialised to zero and the stack pointer is set up.
 //
 // This function should not exit.
 void init(void);
@@ -18,31 +21,16 @@ void init(void);
 // Idle loop routine. Called repeatedly until the end of time.
 void idle(void);
 
-#define PATTERN_TABLE_BASE 0x2000
+// Draw the box and any benchmark results, the first screen shown at boot.
+void draw_screen(void);
 
 #define IO_PORT (*((volatile u8*)0x8400))
-#define VDP_REGISTER_SELECT (*((volatile u8*)0xC000))
-#define VDP_REGISTER_DATA (*((volatile u8*)0xC001))
-#define VDP_VRAM_DATA (*((volatile u8*)0xC002))
-
-#define VDP_REG_READ_ADDR_L     0x00
-#define VDP_REG_READ_ADDR_H     0x01
-#define VDP_REG_WRITE_ADDR_L    0x02
-#define VDP_REG_WRITE_ADDR_H    0x03
-#define VDP_REG_H_DISPLAYED     0x04
-#define VDP_REG_H_BLANK         0x05
-#define VDP_REG_H_FRONT_PORCH   0x06
-#define VDP_REG_V_DISPLAYED     0x07
-#define VDP_REG_V_BLANK         0x08
-#define VDP_REG_V_FRONT_PORCH   0x09
-#define VDP_REG_SYNC_LENGTHS    0x0a
-#define VDP_REG_PTRN_TBL_BASE_L 0x0b
-#define VDP_REG_PTRN_TBL_BASE_H 0x0c
-#define VDP_REG_NAME_TBL_BASE_L 0x0d
-#define VDP_REG_NAME_TBL_BASE_H 0x0e
-#define VDP_REG_ATTR_TBL_BASE_L 0x0f
-#define VDP_REG_ATTR_TBL_BASE_H 0x10
-#define VDP_REG_H_CHARS         0x11
+
+// Values written to the IO port as boot progresses, on entry to init() and
+// once the first screen is drawn. The simulator times them with
+// --boot-report.
+#define IO_BOOT_INIT            0xFF
+#define IO_BOOT_DISPLAY         0xFE
 
 #define BOX_VERT                0xB3
 #define BOX_HORIZ               0xC4
@@ -56,20 +44,63 @@ void idle(void);
 static u8 scr_width, scr_height;
 static u16 attr_base, name_base;
 
-void vdp_set_reg(u8 reg, u8 value);
-void vdp_set_addr(u8 low_reg, u16 value);
 void vdp_mode_640x480(void);
 void vdp_mode_848x480(void);
 
-void copy_font(void);
 void clear_attribute(void);
 
 void delay(u16 i);
 
 void box(u8 left, u8 top, u8 width, u8 height, u8 attr);
 
+void at(u8 x, u8 y, u8 c, u8 attr);
+
+#ifdef BOOT_BENCH
+// Time copying a block of ROM to unused VRAM with a C loop and with DMA.
+#define UPLOAD_SRC              ((const u8*)0xE000)
+#define UPLOAD_DST              0x4000
+#define UPLOAD_LEN              1024
+
+static perf_region upload_loop, upload_dma;
+
+void upload_benchmark(void);
+#endif
+
+#ifdef BOOT_BENCH
+// Time writing characters to the screen with at() and with the console,
+// including the flush.
+#define CHARS_COLUMNS           64
+#define CHARS_ROWS              4
+
+static perf_region chars_at, chars_console;
+
+void chars_benchmark(void);
+
+// Characters per second from CPU cycles taken to write CHARS_COLUMNS *
+// CHARS_ROWS characters.
+u32 chars_per_second(u32 cycles);
+#endif
+
+// Bounce a sprite around the screen, moving it once per frame. The pattern is
+// in the upper VRAM block, away from the name and attribute tables.
+#define SPRITE_BASE             0x8000
+
+static const u8 sprite_ball[8] = {
+    0x3C, 0x7E, 0xFF, 0xFF, 0xFF, 0xFF, 0x7E, 0x3C,
+};
+
+static u16 ball_x = 100, ball_y = 50;
+static i16 ball_dx = 1, ball_dy = 1;
+static u8 ball_frame;
+
+void sprite_init(void);
+void sprite_update(void);
+
 void init(void) {
-    IO_PORT = 0xff;
+    IO_PORT = IO_BOOT_INIT;
+
+    // count frames from the vertical blank interrupt
+    vdp_irq_init();
 
     // enable interrupts
     IRQ_ENABLE();
@@ -84,8 +115,20 @@ void init(void) {
     vdp_mode_640x480();
     //vdp_mode_848x480();
 
-    copy_font();
     clear_attribute();
+    console_init(scr_width, scr_height, name_base, attr_base, 0x4F);
+
+    // Flush the cleared console now so that it does not overwrite the box
+    console_flush();
+
+#ifdef BOOT_BENCH
+    upload_benchmark();
+    chars_benchmark();
+#endif
+
+    draw_screen();
+    sprite_init();
+    IO_PORT = IO_BOOT_DISPLAY;
 
     vdp_set_addr(VDP_REG_WRITE_ADDR_L, 0x0000);
     vdp_set_addr(VDP_REG_READ_ADDR_L, 0x0000);
@@ -96,16 +139,6 @@ void init(void) {
     while(1) { idle(); }
 }
 
-void vdp_set_reg(u8 reg, u8 value) {
-    VDP_REGISTER_SELECT = reg;
-    VDP_REGISTER_DATA = value;
-}
-
-void vdp_set_addr(u8 low_reg, u16 value) {
-    vdp_set_reg(low_reg, value & 0xff);
-    vdp_set_reg(low_reg + 1, (value >> 8) & 0xff);
-}
-
 void vdp_mode_640x480(void) {
     const u8 h_displayed_chars      = 80;
     const u8 h_blank_chars          = 22;
@@ -136,6 +169,12 @@ void vdp_mode_640x480(void) {
         (v_sync_len_lines << 4) | h_sync_len_chars);
 
     vdp_set_reg(VDP_REG_H_CHARS, scr_width);
+    vdp_set_reg(VDP_REG_V_ROWS, scr_height);
+
+    // Use the font in the character ROM
+    vdp_set_reg(VDP_REG_PATTERN_ROM, 1);
+
+    vdp_scroll(0, 0);
 
     vdp_set_addr(VDP_REG_NAME_TBL_BASE_L, name_base);
     vdp_set_addr(VDP_REG_ATTR_TBL_BASE_L, attr_base);
@@ -171,15 +210,33 @@ void vdp_mode_848x480(void) {
         (v_sync_len_lines << 4) | h_sync_len_chars);
 
     vdp_set_reg(VDP_REG_H_CHARS, scr_width);
+    vdp_set_reg(VDP_REG_V_ROWS, scr_height);
+
+    // Use the font in the character ROM
+    vdp_set_reg(VDP_REG_PATTERN_ROM, 1);
+
+    vdp_scroll(0, 0);
 
     vdp_set_addr(VDP_REG_NAME_TBL_BASE_L, name_base);
     vdp_set_addr(VDP_REG_ATTR_TBL_BASE_L, attr_base);
 }
 
+// Offset of a screen position within the name and attribute tables, allowing
+// for the rows the console has scrolled the screen by.
+static u16 screen_offset(u8 x, u8 y) {
+    y += console_top();
+    if(y >= scr_height) {
+        y -= scr_height;
+    }
+    return x + (y * scr_width);
+}
+
 void box(u8 left, u8 top, u8 width, u8 height, u8 attr) {
-    u8 r, c;
+    u8 r;
+    u16 row_offset;
     for(r=0; r<height; ++r) {
-        vdp_set_addr(VDP_REG_WRITE_ADDR_L, name_base + ((r+top)*scr_width) + left);
+        row_offset = screen_offset(left, r+top);
+        vdp_set_addr(VDP_REG_WRITE_ADDR_L, name_base + row_offset);
         if(width > 0) {
             if(r == 0) {
                 VDP_VRAM_DATA = BOX_TL;
@@ -189,14 +246,11 @@ void box(u8 left, u8 top, u8 width, u8 height, u8 attr) {
                 VDP_VRAM_DATA = BOX_VERT;
             }
         }
-        if(((r==0) || (r==(height-1))) && (width > 2)) {
-            for(c=0; c<width-2; ++c) {
-                VDP_VRAM_DATA = BOX_HORIZ;
-            }
-        } else {
-            for(c=0; c<width-2; ++c) {
-                VDP_VRAM_DATA = ' ';
-            }
+        if(width > 2) {
+            vdp_fill(name_base + row_offset + 1,
+                ((r==0) || (r==(height-1))) ? BOX_HORIZ : ' ', width-2);
+            vdp_set_addr(VDP_REG_WRITE_ADDR_L,
+                name_base + row_offset + width - 1);
         }
         if(width > 1) {
             if(r == 0) {
@@ -207,33 +261,94 @@ void box(u8 left, u8 top, u8 width, u8 height, u8 attr) {
                 VDP_VRAM_DATA = BOX_VERT;
             }
         }
-        vdp_set_addr(VDP_REG_WRITE_ADDR_L, attr_base + ((r+top)*scr_width) + left);
-        for(c=0; c<width; ++c) {
-            VDP_VRAM_DATA = attr;
-        }
+        vdp_fill(attr_base + row_offset, attr, width);
     }
 }
 
+// Set every cell to bright white on blue, the colours of the box drawn by
+// idle(). This used to write the low byte of each cell's offset, which showed
+// a pattern of colours until the box was drawn.
 void clear_attribute(void) {
+    vdp_fill(attr_base, 0x4F, scr_width*scr_height);
+    vdp_wait_engine();
+}
+
+#ifdef BOOT_BENCH
+void upload_benchmark(void) {
+    const u8 *src = UPLOAD_SRC;
     u16 i;
 
-    vdp_set_addr(VDP_REG_WRITE_ADDR_L, attr_base);
+    perf_begin(&upload_loop);
+    vdp_set_addr(VDP_REG_WRITE_ADDR_L, UPLOAD_DST);
+    for(i=0; i<UPLOAD_LEN; ++i) {
+        VDP_VRAM_DATA = src[i];
+    }
+    perf_end(&upload_loop);
+
+    perf_begin(&upload_dma);
+    vdp_upload(UPLOAD_SRC, UPLOAD_DST, UPLOAD_LEN);
+    perf_end(&upload_dma);
+}
+#endif
+
+#ifdef BOOT_BENCH
+void chars_benchmark(void) {
+    u8 x, y;
 
-    for(i=0; i<scr_width*scr_height; i++) {
-        VDP_VRAM_DATA = i;
+    perf_begin(&chars_at);
+    for(y=0; y<CHARS_ROWS; ++y) {
+        for(x=0; x<CHARS_COLUMNS; ++x) {
+            at(1 + x, 1 + y, 'A' + (x & 0xf), 0x4F);
+        }
+    }
+    perf_end(&chars_at);
+
+    // Start from a clean console
+    console_flush();
+
+    perf_begin(&chars_console);
+    for(y=0; y<CHARS_ROWS; ++y) {
+        console_goto(1, 1 + y);
+        for(x=0; x<CHARS_COLUMNS; ++x) {
+            console_putc('A' + (x & 0xf));
+        }
     }
+    console_flush();
+    perf_end(&chars_console);
 }
 
-void copy_font(void) {
-    u16 i;
-    const u8* font = font_bin;
+u32 chars_per_second(u32 cycles) {
+    return PERF_CPU_HZ / (cycles / (CHARS_COLUMNS * CHARS_ROWS));
+}
+#endif
+
+void sprite_init(void) {
+    vdp_upload(sprite_ball, SPRITE_BASE, sizeof(sprite_ball));
+    vdp_set_addr(VDP_REG_SPRITE_BASE_L, SPRITE_BASE);
+    vdp_sprite_set(0, ball_x, ball_y, 0x0e, 0);
+    ball_frame = (u8)vdp_frame_count;
+}
 
-    vdp_set_addr(VDP_REG_PTRN_TBL_BASE_L, PATTERN_TABLE_BASE);
-    vdp_set_addr(VDP_REG_WRITE_ADDR_L, PATTERN_TABLE_BASE);
+// Each move is two register writes, or three when the sprite crosses a 256
+// dot or line boundary.
+void sprite_update(void) {
+    u16 x_max = (scr_width << 3) - 8;
+    u16 y_max = (scr_height << 4) - 16;
 
-    for(i=0; i<2048; i++, font++) {
-        VDP_VRAM_DATA = *font;
+    if((u8)vdp_frame_count == ball_frame) {
+        return;
+    }
+    ball_frame = (u8)vdp_frame_count;
+
+    if((ball_x == 0 && ball_dx < 0) || (ball_x == x_max && ball_dx > 0)) {
+        ball_dx = -ball_dx;
+    }
+    if((ball_y == 0 && ball_dy < 0) || (ball_y == y_max && ball_dy > 0)) {
+        ball_dy = -ball_dy;
     }
+    ball_x += ball_dx;
+    ball_y += ball_dy;
+    vdp_sprite_move(0, ball_x, ball_y);
 }
 
 void delay(u16 i) {
@@ -243,17 +358,38 @@ void delay(u16 i) {
 }
 
 void at(u8 x, u8 y, u8 c, u8 attr) {
-    vdp_set_addr(VDP_REG_WRITE_ADDR_L, name_base + x + (y * scr_width));
+    u16 offset = screen_offset(x, y);
+    vdp_set_addr(VDP_REG_WRITE_ADDR_L, name_base + offset);
     VDP_VRAM_DATA = c;
-    vdp_set_addr(VDP_REG_WRITE_ADDR_L, attr_base + x + (y * scr_width));
+    vdp_set_addr(VDP_REG_WRITE_ADDR_L, attr_base + offset);
     VDP_VRAM_DATA = attr;
 }
 
-static u16 ctr = 0, ctr2 = 0, state = 0;
-void idle(void) {
+void draw_screen(void) {
     box(0, 0, scr_width, scr_height, 0x4F);
+    vdp_wait_engine();
+
+    // Benchmark results on the top and bottom of the box
+#ifdef BOOT_BENCH
+    console_goto(2, 0);
+    console_printf("upload: loop %lu, dma %lu cycles",
+        upload_loop.cycles, upload_dma.cycles);
+    console_goto(2, scr_height - 1);
+    console_printf("chars/s: at() %lu, console %lu",
+        chars_per_second(chars_at.cycles),
+        chars_per_second(chars_console.cycles));
+#endif
+    console_flush();
+}
 
+static u16 ctr = 0, ctr2 = 0, state = 0;
+void idle(void) {
     while(1) {
+        // Run any program sent to the UART loader
+        loader_poll();
+
+        sprite_update();
+
         at(
             1 + (rand() % (scr_width-2)),
             1 + (rand() % (scr_height-2)),
@@ -0,0 +1,154 @@
+; Program loader. Receives a program over the UART into the USR region and
+; runs it. See uart.h for the frame format.
+.include "uart.inc"
+.import __USR_START__, __USR_SIZE__
+.importzp ptr1, ptr2, ptr3, tmp1, tmp2, tmp3
+
+USR_END = __USR_START__ + __USR_SIZE__
+
+; Number of 65536 iteration waits for a byte before giving up, about a
+; second. Gaps between USB packets from the host can be several ms.
+TIMEOUT = 40
+
+; void loader_poll(void)
+.export _loader_poll
+.proc _loader_poll
+        bit UART_STATUS         ; anything received?
+        bvs receive
+        rts
+.endproc
+
+; Receive a frame. Returns without a reply if the frame does not start with
+; "LD" or a byte does not arrive in time.
+.proc receive
+        jsr getbyte             ; magic
+        bcs @fail
+        cmp #'L'
+        bne @fail
+        jsr getbyte
+        bcs @fail
+        cmp #'D'
+        bne @fail
+
+        jsr getbyte             ; ptr1 = load_addr = load address
+        bcs @fail
+        sta ptr1
+        sta load_addr
+        jsr getbyte
+        bcs @fail
+        sta ptr1+1
+        sta load_addr+1
+
+        jsr getbyte             ; ptr2 = length
+        bcs @fail
+        sta ptr2
+        jsr getbyte
+        bcs @fail
+        sta ptr2+1
+
+        lda ptr1                ; load address < USR_START?
+        cmp #<__USR_START__
+        lda ptr1+1
+        sbc #>__USR_START__
+        bcc @error
+
+        sec                     ; tmp1/tmp2 = USR_END - load address
+        lda #<USR_END
+        sbc ptr1
+        sta tmp1
+        lda #>USR_END
+        sbc ptr1+1
+        sta tmp2
+        bcc @error
+
+        lda tmp1                ; less than the length?
+        cmp ptr2
+        lda tmp2
+        sbc ptr2+1
+        bcc @error
+
+        stz ptr3                ; ptr3 = sum of bytes
+        stz ptr3+1
+
+@loop:  lda ptr2                ; length == 0?
+        ora ptr2+1
+        beq @check
+
+        jsr getbyte             ; *ptr1 = byte
+        bcs @fail
+        sta (ptr1)
+
+        clc                     ; ptr3 += byte
+        adc ptr3
+        sta ptr3
+        bcc @no_carry
+        inc ptr3+1
+@no_carry:
+
+        inc ptr1                ; ++ptr1
+        bne @no_wrap
+        inc ptr1+1
+@no_wrap:
+
+        lda ptr2                ; --ptr2
+        bne @no_borrow
+        dec ptr2+1
+@no_borrow:
+        dec ptr2
+        bra @loop
+
+@check: jsr getbyte             ; compare sum
+        bcs @fail
+        cmp ptr3
+        bne @error
+        jsr getbyte
+        bcs @fail
+        cmp ptr3+1
+        bne @error
+
+        lda #'K'                ; acknowledge and run the program
+        jsr putbyte
+        jmp (load_addr)         ; the program returns to our caller
+
+@error: lda #'E'
+        jsr putbyte
+@fail:  rts
+.endproc
+
+; Wait for a received byte. Returns it in A with carry clear, or with carry
+; set if none arrives in time.
+.proc getbyte
+        stz tmp1
+        stz tmp2
+        lda #TIMEOUT
+        sta tmp3
+@wait:  bit UART_STATUS
+        bvs @ready
+        dec tmp1
+        bne @wait
+        dec tmp2
+        bne @wait
+        dec tmp3
+        bne @wait
+        sec
+        rts
+@ready: lda UART_DATA
+        clc
+        rts
+.endproc
+
+; Send the byte in A, waiting for space in the transmit FIFO.
+.proc putbyte
+        pha
+@wait:  lda UART_STATUS
+        and #UART_TX_FULL
+        bne @wait
+        pla
+        sta UART_DATA
+        rts
+.endproc
+
+.bss
+
+; Address to run the loaded program from
+load_addr:      .res 2
@@ -0,0 +1,19 @@
+#include "types.h"
+#include "perf.h"
+
+u32 perf_read(u8 counter) {
+    PERF_CONTROL = PERF_SNAPSHOT;
+    return PERF_COUNTER(counter);
+}
+
+void perf_begin(perf_region *region) {
+    PERF_CONTROL = PERF_SNAPSHOT;
+    region->cycles = PERF_COUNTER(PERF_CPU_CYCLES);
+    region->stalls = PERF_COUNTER(PERF_STALL_CYCLES);
+}
+
+void perf_end(perf_region *region) {
+    PERF_CONTROL = PERF_SNAPSHOT;
+    region->cycles = PERF_COUNTER(PERF_CPU_CYCLES) - region->cycles;
+    region->stalls = PERF_COUNTER(PERF_STALL_CYCLES) - region->stalls;
+}
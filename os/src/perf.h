@@ -0,0 +1,41 @@
+#ifndef PERF_H__
+#define PERF_H__
+
+#include "types.h"
+
+// Performance counters. Writing PERF_SNAPSHOT to PERF_CONTROL copies the
+// counters to where they may be read. PERF_CLEAR clears them.
+#define PERF_CONTROL (*((volatile u8*)0x8420))
+#define PERF_COUNTER(n) (*((volatile u32*)(0x8420 + ((n) << 2))))
+
+// CPU clock in Hz, for converting cycle counts to time. This is for the
+// default CPU_DIV_W of 2 in the top-level Makefile.
+#define PERF_CPU_HZ             15750000UL
+
+#define PERF_SNAPSHOT           0x01
+#define PERF_CLEAR              0x02
+
+#define PERF_CPU_CYCLES         0
+#define PERF_STALL_CYCLES       1
+#define PERF_ROM_CYCLES         2
+#define PERF_RAM_CYCLES         3
+#define PERF_VDP_CYCLES         4
+#define PERF_IO_CYCLES          5
+#define PERF_VRAM_WRITES        6
+#define PERF_FRAMES             7
+
+typedef struct {
+    u32 cycles;
+    u32 stalls;
+} perf_region;
+
+// Read a counter. The value is taken from a new snapshot.
+u32 perf_read(u8 counter);
+
+// Measure a region of code. perf_begin() records the counters and
+// perf_end() replaces them with the CPU cycles and stall cycles since. The
+// counters keep running so regions may be nested.
+void perf_begin(perf_region *region);
+void perf_end(perf_region *region);
+
+#endif // PERF_H__
@@ -1,10 +1,11 @@
 ; Reset handler.
 .import first_isr, isr_tail
 .import __DATA_LOAD__, __DATA_RUN__, __DATA_SIZE__
-.importzp ptr1, ptr2, ptr3
+.import __BSS_RUN__, __BSS_SIZE__
+.importzp ptr1, ptr2
 
-; The reset handler. Initialises zero page to zero and transfers control to C
-; init() function.
+; The reset handler. Copies initialised data to RAM, zeroes BSS and
+; zero-page and transfers control to C init() function.
 .export reset
 .proc reset
         sei                     ; disable interrupts
@@ -13,12 +14,14 @@
         ldx #$FF                ; initialise stack pointer to $01FF
         txs
 
-        jsr copy_data           ; copy read-wrtie initialised data to RAM
+        jsr copy_data           ; copy read-write initialised data to RAM
+        jsr zero_bss            ; zero uninitialised data
 
-        ldx #0                  ; fill zero-page with zeros
-@loop:  stz 0,X
+        ldx #0                  ; fill zero-page with zeros, two bytes
+@loop:  stz $00,X               ; per iteration
+        stz $80,X
         inx
-        bne @loop
+        bpl @loop
 
                                 ; initialise C stack pointer to point to
                                 ; top of stack
@@ -38,50 +41,66 @@
         jmp _init
 .endproc
 
-; Copy initialised data to RAM.
+; Copy initialised data to RAM. Whole pages are copied with Y as the index
+; and the pointers' high bytes advanced after each, then the remainder.
 .export copy_data
 .proc copy_data
         lda #<__DATA_LOAD__     ; ptr1 = __DATA_LOAD__
-        ldx #>__DATA_LOAD__
         sta ptr1
-        stx ptr1+1
+        lda #>__DATA_LOAD__
+        sta ptr1+1
 
         lda #<__DATA_RUN__      ; ptr2 = __DATA_RUN__
-        ldx #>__DATA_RUN__
         sta ptr2
-        stx ptr2+1
-
-        lda #<__DATA_SIZE__     ; ptr3 = __DATA_SIZE__
-        ldx #>__DATA_SIZE__     ; ptr3 stores number of bytes left to copy
-        sta ptr3
-        stx ptr3+1
-
-@loop:
-        lda ptr3                ; ptr3 == 0?
-        bne @body
-        lda ptr3
-        bne @body
-        rts                     ; yes, all done so return
-
-@body:                          ; loop body
-
-        lda (ptr1)              ; *ptr2 = *ptr1
-        sta (ptr2)
-
-        lda #0                  ; ++ptr1
-        clc
-        inc ptr1
-        adc ptr1 + 1
-
-        lda #0                  ; ++ptr2
-        clc
-        inc ptr2
-        adc ptr2 + 1
-
-        lda #0                  ; --ptr3
-        clc
-        dec ptr3
-        sbc ptr3 + 1
+        lda #>__DATA_RUN__
+        sta ptr2+1
+
+        ldy #0
+        ldx #>__DATA_SIZE__     ; X = whole pages left to copy
+        beq @rest
+
+@page:  lda (ptr1),Y            ; copy a page
+        sta (ptr2),Y
+        iny
+        bne @page
+        inc ptr1+1
+        inc ptr2+1
+        dex
+        bne @page
+
+@rest:  cpy #<__DATA_SIZE__     ; copy the remaining bytes, Y is zero here
+        beq @done
+        lda (ptr1),Y
+        sta (ptr2),Y
+        iny
+        bne @rest
+@done:  rts
+.endproc
 
-        bra @loop               ; next iteration
+; Zero the BSS segment, a page at a time as for copy_data.
+.export zero_bss
+.proc zero_bss
+        lda #<__BSS_RUN__       ; ptr1 = __BSS_RUN__
+        sta ptr1
+        lda #>__BSS_RUN__
+        sta ptr1+1
+
+        lda #0
+        tay
+        ldx #>__BSS_SIZE__      ; X = whole pages left to zero
+        beq @rest
+
+@page:  sta (ptr1),Y            ; zero a page
+        iny
+        bne @page
+        inc ptr1+1
+        dex
+        bne @page
+
+@rest:  cpy #<__BSS_SIZE__      ; zero the remaining bytes, Y is zero here
+        beq @done
+        sta (ptr1),Y
+        iny
+        bne @rest
+@done:  rts
 .endproc
@@ -0,0 +1,34 @@
+#ifndef UART_H__
+#define UART_H__
+
+#include "types.h"
+
+// UART, the bc6502 UART. See uart.v. Reading UART_DATA removes a byte from
+// the receive FIFO. Writing it queues a byte to transmit. Writing UART_ERROR
+// empties both FIFOs and clears the overrun flag. The baud rate is set by the
+// hardware at reset.
+#define UART_DATA (*((volatile u8*)0x8408))
+#define UART_STATUS (*((volatile u8*)0x8409))
+#define UART_CONTROL (*((volatile u8*)0x840A))
+#define UART_ERROR (*((volatile u8*)0x840B))
+
+// Bits in UART_STATUS
+#define UART_RX_READY           0x40
+#define UART_RX_FULL            0x20
+#define UART_TX_EMPTY           0x10
+#define UART_TX_FULL            0x08
+
+// Bits in UART_ERROR
+#define UART_OVERRUN            0x80
+#define UART_FRAME_ERROR        0x40
+
+// Program loader. If a byte has been received, try to receive a program
+// frame and run it. The program is called as a function and may return.
+//
+// A frame is "LD", the load address and length (16 bits each, little
+// endian), the program and the 16 bit sum of its bytes. The program must lie
+// within the USR region. The loader replies 'K' before running the program or
+// 'E' if the frame is rejected.
+void loader_poll(void);
+
+#endif // UART_H__
@@ -0,0 +1,133 @@
+#include "interrupt.h"
+#include "types.h"
+#include "vdp.h"
+
+volatile u16 vdp_frame_count;
+volatile u16 vdp_line_count;
+
+static u8 irq_enable;
+
+void vdp_set_reg(u8 reg, u8 value) {
+    VDP_REGISTER_SELECT = reg;
+    VDP_REGISTER_DATA = value;
+}
+
+void vdp_set_addr(u8 low_reg, u16 value) {
+    vdp_set_reg(low_reg, value & 0xff);
+    vdp_set_reg(low_reg + 1, (value >> 8) & 0xff);
+}
+
+void vdp_read(void *dst, u16 src, u16 len) {
+    u8 *d = (u8*)dst;
+
+    vdp_set_addr(VDP_REG_READ_ADDR_L, src);
+    while(len) {
+        *d++ = VDP_VRAM_DATA;
+        --len;
+    }
+}
+
+void vdp_wait_engine(void) {
+    while(VDP_STATUS & VDP_STATUS_ENGINE_BUSY) { }
+}
+
+void vdp_fill(u16 dst, u8 value, u16 len) {
+    vdp_wait_engine();
+    vdp_set_addr(VDP_REG_ENGINE_DST_L, dst);
+    vdp_set_addr(VDP_REG_ENGINE_LEN_L, len);
+    vdp_set_reg(VDP_REG_ENGINE_FILL, value);
+    vdp_set_reg(VDP_REG_ENGINE_CMD, VDP_ENGINE_FILL);
+}
+
+// Copies are performed in ascending address order and so overlapping ranges
+// are only safe if dst < src.
+void vdp_copy(u16 dst, u16 src, u16 len) {
+    vdp_wait_engine();
+    vdp_set_addr(VDP_REG_ENGINE_SRC_L, src);
+    vdp_set_addr(VDP_REG_ENGINE_DST_L, dst);
+    vdp_set_addr(VDP_REG_ENGINE_LEN_L, len);
+    vdp_set_reg(VDP_REG_ENGINE_CMD, VDP_ENGINE_COPY);
+}
+
+void vdp_scroll(u16 x, u16 y) {
+    vdp_set_reg(VDP_REG_SCROLL_X, x >> 3);
+    vdp_set_reg(VDP_REG_SCROLL_Y, y >> 4);
+    vdp_set_reg(VDP_REG_SCROLL_FINE, ((y & 0x0f) << 4) | (x & 0x07));
+}
+
+// Sprite control registers as last written. The high bits of the position
+// share a register with the colour and enable, so moving a sprite only writes
+// it when they change.
+static u8 sprite_ctrl[VDP_SPRITES];
+
+static void sprite_position(u8 n, u16 x, u16 y, u8 ctrl) {
+    u8 reg = VDP_REG_SPRITE(n);
+
+    ctrl = (ctrl & 0x8f) | ((y >> 2) & 0x40) | ((x >> 4) & 0x30);
+    vdp_set_reg(reg + VDP_SPRITE_X, x & 0xff);
+    vdp_set_reg(reg + VDP_SPRITE_Y, y & 0xff);
+    if(ctrl != sprite_ctrl[n]) {
+        sprite_ctrl[n] = ctrl;
+        vdp_set_reg(reg + VDP_SPRITE_CTRL, ctrl);
+    }
+}
+
+void vdp_sprite_set(u8 n, u16 x, u16 y, u8 colour, u8 pattern) {
+    vdp_set_reg(VDP_REG_SPRITE(n) + VDP_SPRITE_PATTERN, pattern);
+    sprite_position(n, x, y, VDP_SPRITE_ENABLE | (colour & 0x0f));
+}
+
+void vdp_sprite_move(u8 n, u16 x, u16 y) {
+    sprite_position(n, x, y, sprite_ctrl[n]);
+}
+
+void vdp_sprite_hide(u8 n) {
+    sprite_ctrl[n] = 0;
+    vdp_set_reg(VDP_REG_SPRITE(n) + VDP_SPRITE_CTRL, 0);
+}
+
+// Acknowledge and count VDP interrupts. This only uses the A, X and Y
+// registers which are saved by isr_head.
+IRQ_ISR_BEGIN(vdp)
+    if(VDP_STATUS & VDP_STATUS_VBLANK) {
+        VDP_STATUS = VDP_STATUS_VBLANK;
+        ++vdp_frame_count;
+    }
+    if(VDP_STATUS & VDP_STATUS_LINE) {
+        VDP_STATUS = VDP_STATUS_LINE;
+        ++vdp_line_count;
+    }
+IRQ_ISR_END(vdp)
+
+void vdp_irq_init(void) {
+    IRQ_REGISTER_ISR(vdp);
+
+    // Discard anything latched before we were listening.
+    VDP_STATUS = VDP_STATUS_VBLANK | VDP_STATUS_LINE;
+
+    irq_enable = VDP_IRQ_VBLANK;
+    vdp_set_reg(VDP_REG_IRQ_ENABLE, irq_enable);
+}
+
+void vdp_set_line_irq(u16 line) {
+    vdp_set_addr(VDP_REG_LINE_COMPARE_L, line);
+    irq_enable |= VDP_IRQ_LINE;
+    vdp_set_reg(VDP_REG_IRQ_ENABLE, irq_enable);
+}
+
+void vdp_disable_line_irq(void) {
+    irq_enable &= ~VDP_IRQ_LINE;
+    vdp_set_reg(VDP_REG_IRQ_ENABLE, irq_enable);
+}
+
+// Only the low byte of the counters is compared since the ISR may update the
+// high byte between our reads.
+void vdp_wait_vblank(void) {
+    u8 frame = (u8)vdp_frame_count;
+    while((u8)vdp_frame_count == frame) { }
+}
+
+void vdp_wait_line(void) {
+    u8 line = (u8)vdp_line_count;
+    while((u8)vdp_line_count == line) { }
+}
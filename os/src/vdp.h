@@ -0,0 +1,118 @@
+#ifndef VDP_H__
+#define VDP_H__
+
+#include "types.h"
+
+#define VDP_REGISTER_SELECT (*((volatile u8*)0xC000))
+#define VDP_REGISTER_DATA (*((volatile u8*)0xC001))
+#define VDP_VRAM_DATA (*((volatile u8*)0xC002))
+#define VDP_STATUS (*((volatile u8*)0xC003))
+
+#define VDP_STATUS_WRITE_FIFO_FULL  0x80
+#define VDP_STATUS_ENGINE_BUSY      0x40
+#define VDP_STATUS_VBLANK           0x20
+#define VDP_STATUS_LINE             0x10
+#define VDP_STATUS_WRITE_FIFO_LEVEL 0x0f
+
+#define VDP_REG_READ_ADDR_L     0x00
+#define VDP_REG_READ_ADDR_H     0x01
+#define VDP_REG_WRITE_ADDR_L    0x02
+#define VDP_REG_WRITE_ADDR_H    0x03
+#define VDP_REG_H_DISPLAYED     0x04
+#define VDP_REG_H_BLANK         0x05
+#define VDP_REG_H_FRONT_PORCH   0x06
+#define VDP_REG_V_DISPLAYED     0x07
+#define VDP_REG_V_BLANK         0x08
+#define VDP_REG_V_FRONT_PORCH   0x09
+#define VDP_REG_SYNC_LENGTHS    0x0a
+#define VDP_REG_PTRN_TBL_BASE_L 0x0b
+#define VDP_REG_PTRN_TBL_BASE_H 0x0c
+#define VDP_REG_NAME_TBL_BASE_L 0x0d
+#define VDP_REG_NAME_TBL_BASE_H 0x0e
+#define VDP_REG_ATTR_TBL_BASE_L 0x0f
+#define VDP_REG_ATTR_TBL_BASE_H 0x10
+#define VDP_REG_H_CHARS         0x11
+#define VDP_REG_ENGINE_SRC_L    0x12
+#define VDP_REG_ENGINE_SRC_H    0x13
+#define VDP_REG_ENGINE_DST_L    0x14
+#define VDP_REG_ENGINE_DST_H    0x15
+#define VDP_REG_ENGINE_LEN_L    0x16
+#define VDP_REG_ENGINE_LEN_H    0x17
+#define VDP_REG_ENGINE_FILL     0x18
+#define VDP_REG_ENGINE_CMD      0x19
+#define VDP_REG_IRQ_ENABLE      0x1a
+#define VDP_REG_LINE_COMPARE_L  0x1b
+#define VDP_REG_LINE_COMPARE_H  0x1c
+#define VDP_REG_SCROLL_X        0x1d
+#define VDP_REG_SCROLL_Y        0x1e
+#define VDP_REG_SCROLL_FINE     0x1f
+#define VDP_REG_V_ROWS          0x20
+#define VDP_REG_PATTERN_ROM     0x21
+#define VDP_REG_SPRITE_BASE_L   0x22
+#define VDP_REG_SPRITE_BASE_H   0x23
+
+// Registers of sprite n, 0 to VDP_SPRITES-1
+#define VDP_REG_SPRITE(n)       (0x40 + ((n) << 2))
+#define VDP_SPRITE_X            0
+#define VDP_SPRITE_Y            1
+#define VDP_SPRITE_CTRL         2
+#define VDP_SPRITE_PATTERN      3
+
+#define VDP_SPRITES             8
+#define VDP_SPRITE_ENABLE       0x80
+
+#define VDP_ENGINE_FILL         0x01
+#define VDP_ENGINE_COPY         0x02
+
+#define VDP_IRQ_VBLANK          0x01
+#define VDP_IRQ_LINE            0x02
+
+void vdp_set_reg(u8 reg, u8 value);
+void vdp_set_addr(u8 low_reg, u16 value);
+
+// Copy from VRAM. Each read of VDP_VRAM_DATA advances the read address and the
+// VDP holds the CPU until the next byte has been fetched. Bytes written by the
+// block engine read back correctly once the engine has finished.
+void vdp_read(void *dst, u16 src, u16 len);
+
+// Copy to VRAM with the DMA controller. The CPU is held until the copy is
+// complete, at about two CPU cycles per byte. Afterwards VDP register 3 is
+// selected and the write address is dst + len.
+void vdp_upload(const void *src, u16 dst, u16 len);
+
+// Block fill/copy engine. Commands run in the background; vdp_fill() and
+// vdp_copy() wait for any previous command to finish before starting.
+void vdp_wait_engine(void);
+void vdp_fill(u16 dst, u8 value, u16 len);
+void vdp_copy(u16 dst, u16 src, u16 len);
+
+// Scroll the display to a pixel position within the virtual screen. Text rows
+// are 16 lines high. The first column is blanked if x is not a multiple of 8.
+void vdp_scroll(u16 x, u16 y);
+
+// Sprites are 8x8 patterns, 8 bytes each from the sprite pattern table at
+// VDP_REG_SPRITE_BASE_L, drawn over the characters with each row two lines
+// high. vdp_sprite_set() sets all of a sprite's registers and
+// vdp_sprite_move() only its position. Both take a position in dots and lines
+// from the top left of the display.
+void vdp_sprite_set(u8 n, u16 x, u16 y, u8 colour, u8 pattern);
+void vdp_sprite_move(u8 n, u16 x, u16 y);
+void vdp_sprite_hide(u8 n);
+
+// Register the VDP interrupt service routine and enable the vertical blank
+// interrupt. Must be called with interrupts disabled.
+void vdp_irq_init(void);
+
+// Interrupt on the horizontal blank preceding a visible line.
+void vdp_set_line_irq(u16 line);
+void vdp_disable_line_irq(void);
+
+// Wait for the start of the next vertical blank or line compare interrupt.
+void vdp_wait_vblank(void);
+void vdp_wait_line(void);
+
+// Number of vertical blank and line compare interrupts taken so far.
+extern volatile u16 vdp_frame_count;
+extern volatile u16 vdp_line_count;
+
+#endif // VDP_H__
@@ -0,0 +1,27 @@
+; Copy to VRAM with the DMA controller.
+.include "dma.inc"
+.import popax
+
+; void vdp_upload(const void *src, u16 dst, u16 len)
+;
+; The DMA controller sets the VDP write address itself so setting up a copy
+; is a handful of stores. len is passed in A/X and dst and src are on the C
+; stack. On return VDP register 3 is selected and the write address is
+; dst + len.
+.export _vdp_upload
+.proc _vdp_upload
+        sta DMA_LEN             ; length
+        stx DMA_LEN+1
+
+        jsr popax               ; destination
+        sta DMA_DST
+        stx DMA_DST+1
+
+        jsr popax               ; source
+        sta DMA_SRC
+        stx DMA_SRC+1
+
+        lda #(DMA_DONE | DMA_START)
+        sta DMA_CONTROL         ; acknowledge any previous copy and start
+        rts                     ; the CPU is held until the copy is done
+.endproc
@@ -0,0 +1,24 @@
+; Example program for the UART loader. Sends a greeting, sets the IO port and
+; returns to the OS.
+.include "uart.inc"
+
+IO_PORT = $8400
+
+.code
+        ldx #0
+@loop:  lda #UART_TX_FULL       ; wait for space to transmit
+@wait:  bit UART_STATUS
+        bne @wait
+        lda message,X           ; send next character
+        beq @done
+        sta UART_DATA
+        inx
+        bra @loop
+
+@done:  lda #$A5
+        sta IO_PORT
+        rts
+
+.rodata
+message:
+        .byte "Hello from RAM", 13, 10, 0
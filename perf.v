@@ -0,0 +1,106 @@
+// Performance counters
+//
+// Eight free-running 32 bit counters which count CPU bus activity and VDP
+// events. The CPU reads a snapshot of the counters so that a multi-byte
+// counter is consistent while it is read byte by byte.
+//
+// Writing to register 0 controls the counters. Bit 0 copies the counters into
+// the snapshot. Bit 1 clears the counters. If both are set the snapshot is
+// taken before the counters are cleared.
+//
+// Counters, each read little-endian from addr 4*n:
+//
+//   0  CPU cycles
+//   1  CPU cycles with RDY low
+//   2  CPU cycles addressing ROM
+//   3  CPU cycles addressing RAM, including the banked window
+//   4  CPU cycles addressing the VDP
+//   5  CPU cycles addressing other IO
+//   6  CPU writes completed to VRAM
+//   7  frames displayed
+module perf_counters(
+  input reset,
+  input clk,
+  input cpu_ce,
+  input rdy,
+
+  input rom_cycle,
+  input ram_cycle,
+  input vdp_cycle,
+  input io_cycle,
+  input vram_write,
+  input frame,
+
+  input [4:0] addr,
+  input write,
+  input [7:0] data_in,
+  output [7:0] data_out
+);
+
+localparam COUNTERS = 8;
+
+reg [31:0] counter [0:COUNTERS-1];
+reg [31:0] snapshot [0:COUNTERS-1];
+
+reg write_reg = 0;
+
+// Act once per control write so that a snapshot is not retaken after a clear.
+wire control_write = write && ~write_reg && (addr == 0);
+
+// Each CPU cycle is counted on its last clock, when the CPU samples RDY. The
+// address is stable throughout the cycle.
+wire cycle_end = cpu_ce;
+
+wire [31:0] snapshot_word = snapshot[addr[4:2]];
+assign data_out = snapshot_word[{addr[1:0], 3'b000} +: 8];
+
+wire [COUNTERS-1:0] increment = {
+  frame,
+  vram_write,
+  cycle_end && io_cycle,
+  cycle_end && vdp_cycle,
+  cycle_end && ram_cycle,
+  cycle_end && rom_cycle,
+  cycle_end && ~rdy,
+  cycle_end
+};
+
+integer i;
+
+always @(posedge clk) begin
+  write_reg <= write;
+
+  if(control_write && data_in[0]) begin
+    for(i=0; i<COUNTERS; i=i+1) begin
+      snapshot[i] <= counter[i];
+    end
+  end
+
+  if(reset || (control_write && data_in[1])) begin
+    for(i=0; i<COUNTERS; i=i+1) begin
+      counter[i] <= 0;
+    end
+  end else begin
+    for(i=0; i<COUNTERS; i=i+1) begin
+      if(increment[i]) begin
+        counter[i] <= counter[i] + 1;
+      end
+    end
+  end
+end
+
+`ifdef VERILATOR
+// Report the counters when the simulation ends.
+final begin
+  $display("perf: cpu cycles   %0d", counter[0]);
+  $display("perf: rdy low      %0d", counter[1]);
+  $display("perf: rom cycles   %0d", counter[2]);
+  $display("perf: ram cycles   %0d", counter[3]);
+  $display("perf: vdp cycles   %0d", counter[4]);
+  $display("perf: io cycles    %0d", counter[5]);
+  $display("perf: vram writes  %0d", counter[6]);
+  $display("perf: frames       %0d", counter[7]);
+end
+`endif
+
+endmodule
@@ -0,0 +1,404 @@
+// Fast whole-system simulator.
+//
+// The computer module is compiled with Verilator and its 63MHz system clock is
+// driven from here. The boot ROM is loaded from bootrom.hex in the current
+// directory by bootrom.v.
+//
+// The UART lines are connected to a model serial port. Characters sent by the
+// computer are written to stdout and the contents of a file, usually a frame
+// made by tools/uart-load.py, may be sent to it once the OS is running.
+//
+// With --boot-report the time taken to boot the OS is measured from the IO
+// port, which init() sets to IO_BOOT_INIT on entry and to IO_BOOT_DISPLAY once
+// the first screen is drawn. The simulation stops at the first visible line of the
+// first frame after that. This is found from the VDP display enable: it is the
+// first line to start after display enable has been low for several lines.
+//
+// Usage: Vcomputer [--cycles N] [--frames N] [--vcd FILE]
+//                  [--vcd-window START:END]... [--trace-io]
+//                  [--uart-in FILE] [--uart-at-frame N] [--until-io VALUE]
+//                  [--boot-report]
+//
+// Pass +bootrom=FILE to run another ROM image.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Vcomputer.h"
+#include "verilated.h"
+#include "verilated_vcd_c.h"
+
+namespace {
+
+// System clock
+const double SYSTEM_CLOCK_HZ = 63e6;
+const uint64_t CLOCK_PERIOD_PS = 15873;
+
+// System clock cycles per bit on the serial line. This must match BAUD_MUL in
+// uart.v, which gives 2**20 / BAUD_MUL clocks per bit.
+const uint64_t UART_BIT_CYCLES = 63;
+
+// System clock cycles for which the computer is held in reset. This must match
+// RESET_CTR_WIDTH in reset_timer.v.
+const uint64_t RESET_CYCLES = 64;
+
+// Values written to the IO port as the OS boots. These must match
+// os/src/init.c.
+const uint8_t IO_BOOT_INIT = 0xff;
+const uint8_t IO_BOOT_DISPLAY = 0xfe;
+
+// Range of cycles to record in the VCD file
+struct VcdWindow {
+    uint64_t start;
+    uint64_t end;
+};
+
+struct Options {
+    uint64_t max_cycles = 0;
+    uint64_t max_frames = 0;
+    std::string vcd_path;
+    std::vector<VcdWindow> vcd_windows;
+    bool trace_io = false;
+    std::string uart_in_path;
+    uint64_t uart_at_frame = 2;
+    int until_io = -1;
+    bool boot_report = false;
+};
+
+// Cycles at which each stage of booting was reached, or zero
+struct BootTimes {
+    uint64_t init = 0;
+    uint64_t display = 0;
+    uint64_t line = 0;
+};
+
+void print_boot_time(const char* stage, uint64_t cycle) {
+    if(cycle == 0) {
+        std::printf("boot: %-16s not reached\n", stage);
+        return;
+    }
+    uint64_t after_reset = cycle - RESET_CYCLES;
+    std::printf("boot: %-16s %llu cycles after reset, %.3f ms\n", stage,
+        (unsigned long long)after_reset, after_reset / SYSTEM_CLOCK_HZ * 1e3);
+}
+
+// Send bytes to the computer as 8N1 characters, one after another.
+class UartSender {
+public:
+    explicit UartSender(const std::vector<uint8_t>& data) : data_(data) {}
+
+    bool done() const { return index_ >= data_.size() * 10; }
+
+    // Level of the line for the current cycle
+    uint8_t tick() {
+        if(done()) {
+            return 1;
+        }
+        uint8_t level;
+        size_t bit = index_ % 10;
+        if(bit == 0) {
+            level = 0;
+        } else if(bit == 9) {
+            level = 1;
+        } else {
+            level = (data_[index_ / 10] >> (bit - 1)) & 1;
+        }
+        if(++timer_ == UART_BIT_CYCLES) {
+            timer_ = 0;
+            ++index_;
+        }
+        return level;
+    }
+
+private:
+    std::vector<uint8_t> data_;
+    size_t index_ = 0;
+    uint64_t timer_ = 0;
+};
+
+// Decode 8N1 characters sent by the computer, sampling the middle of each bit.
+class UartReceiver {
+public:
+    // Returns a received character or -1.
+    int tick(uint8_t level) {
+        if(bit_ < 0) {
+            if(level == 0) {
+                bit_ = 0;
+                timer_ = UART_BIT_CYCLES / 2;
+            }
+            return -1;
+        }
+        if(timer_ != 0) {
+            --timer_;
+            return -1;
+        }
+        timer_ = UART_BIT_CYCLES - 1;
+        if(bit_ == 0) {
+            // A start bit which has gone away was a glitch
+            bit_ = (level == 0) ? 1 : -1;
+        } else if(bit_ <= 8) {
+            shift_ = (shift_ >> 1) | (level << 7);
+            ++bit_;
+        } else {
+            bit_ = -1;
+            if(level == 1) {
+                return shift_;
+            }
+        }
+        return -1;
+    }
+
+private:
+    int bit_ = -1;
+    uint64_t timer_ = 0;
+    uint8_t shift_ = 0;
+};
+
+void usage(const char* argv0) {
+    std::fprintf(stderr,
+        "usage: %s [--cycles N] [--frames N] [--vcd FILE]\n"
+        "       [--vcd-window START:END]... [--trace-io]\n"
+        "       [--uart-in FILE] [--uart-at-frame N] [--until-io VALUE]\n"
+        "       [--boot-report]\n"
+        "\n"
+        "  --cycles N              stop after N system clock cycles\n"
+        "  --frames N              stop after N frames (vsync pulses)\n"
+        "  --vcd FILE              write a VCD trace to FILE\n"
+        "  --vcd-window START:END  only trace cycles in [START, END)\n"
+        "  --trace-io              print each change of the IO port\n"
+        "  --uart-in FILE          send the contents of FILE to the UART\n"
+        "  --uart-at-frame N       start sending after N frames (default 2)\n"
+        "  --until-io VALUE        stop when the IO port is set to VALUE\n"
+        "  --boot-report           time the OS boot and stop at its first\n"
+        "                          visible line\n",
+        argv0);
+}
+
+bool parse_u64(const char* s, uint64_t* value) {
+    char* end;
+    *value = std::strtoull(s, &end, 0);
+    return (*s != '\0') && (*end == '\0');
+}
+
+bool parse_window(const char* s, VcdWindow* window) {
+    const char* colon = std::strchr(s, ':');
+    if(colon == nullptr) {
+        return false;
+    }
+    std::string start(s, colon);
+    return parse_u64(start.c_str(), &window->start)
+        && parse_u64(colon + 1, &window->end)
+        && (window->start < window->end);
+}
+
+bool parse_options(int argc, char** argv, Options* options) {
+    for(int i=1; i<argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i+1 < argc) ? argv[i+1] : nullptr;
+
+        if(arg[0] == '+') {
+            // Verilator plusarg
+            continue;
+        } else if(std::strcmp(arg, "--trace-io") == 0) {
+            options->trace_io = true;
+            continue;
+        } else if(std::strcmp(arg, "--boot-report") == 0) {
+            options->boot_report = true;
+            continue;
+        } else if(value == nullptr) {
+            return false;
+        }
+
+        if(std::strcmp(arg, "--cycles") == 0) {
+            if(!parse_u64(value, &options->max_cycles)) { return false; }
+        } else if(std::strcmp(arg, "--frames") == 0) {
+            if(!parse_u64(value, &options->max_frames)) { return false; }
+        } else if(std::strcmp(arg, "--vcd") == 0) {
+            options->vcd_path = value;
+        } else if(std::strcmp(arg, "--vcd-window") == 0) {
+            VcdWindow window;
+            if(!parse_window(value, &window)) { return false; }
+            options->vcd_windows.push_back(window);
+        } else if(std::strcmp(arg, "--uart-in") == 0) {
+            options->uart_in_path = value;
+        } else if(std::strcmp(arg, "--uart-at-frame") == 0) {
+            if(!parse_u64(value, &options->uart_at_frame)) { return false; }
+        } else if(std::strcmp(arg, "--until-io") == 0) {
+            uint64_t io;
+            if(!parse_u64(value, &io) || (io > 0xff)) { return false; }
+            options->until_io = io;
+        } else {
+            return false;
+        }
+        ++i;
+    }
+
+    // Without a limit we would never stop.
+    return (options->max_cycles != 0) || (options->max_frames != 0)
+        || (options->until_io >= 0);
+}
+
+bool in_vcd_window(const Options& options, uint64_t cycle) {
+    if(options.vcd_windows.empty()) {
+        return true;
+    }
+    for(const VcdWindow& window : options.vcd_windows) {
+        if((cycle >= window.start) && (cycle < window.end)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if(!parse_options(argc, argv, &options)) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<uint8_t> uart_in;
+    if(!options.uart_in_path.empty()) {
+        std::ifstream file(options.uart_in_path, std::ios::binary);
+        if(!file) {
+            std::fprintf(stderr, "cannot open %s\n", options.uart_in_path.c_str());
+            return EXIT_FAILURE;
+        }
+        uart_in.assign(std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>());
+    }
+    UartSender uart_sender(uart_in);
+    UartReceiver uart_receiver;
+
+    Verilated::commandArgs(argc, argv);
+
+    std::unique_ptr<Vcomputer> computer(new Vcomputer);
+    std::unique_ptr<VerilatedVcdC> vcd;
+    if(!options.vcd_path.empty()) {
+        Verilated::traceEverOn(true);
+        vcd.reset(new VerilatedVcdC);
+        computer->trace(vcd.get(), 99);
+        vcd->open(options.vcd_path.c_str());
+    }
+
+    uint64_t cycle = 0, frames = 0;
+    uint8_t vsync = 0, hsync = 0, de = 0, io_port = 0;
+    uint64_t blank_hsync_edges = 0;
+    BootTimes boot;
+
+    computer->clk = 0;
+    computer->uart_rx = 1;
+    computer->eval();
+    vsync = computer->vsync;
+    hsync = computer->hsync;
+    de = computer->de;
+    io_port = computer->io_port;
+
+    auto wall_start = std::chrono::steady_clock::now();
+
+    while(!Verilated::gotFinish()) {
+        if((options.max_cycles != 0) && (cycle >= options.max_cycles)) {
+            break;
+        }
+        if((options.max_frames != 0) && (frames >= options.max_frames)) {
+            break;
+        }
+
+        bool dump = vcd && in_vcd_window(options, cycle);
+
+        if(frames >= options.uart_at_frame) {
+            computer->uart_rx = uart_sender.tick();
+        }
+
+        computer->clk = 1;
+        computer->eval();
+        if(dump) { vcd->dump(cycle * CLOCK_PERIOD_PS); }
+
+        computer->clk = 0;
+        computer->eval();
+        if(dump) { vcd->dump(cycle * CLOCK_PERIOD_PS + CLOCK_PERIOD_PS / 2); }
+
+        ++cycle;
+
+        // Count a frame on each rising edge of vsync. The VDP sync polarity is
+        // programmable so this is the start of the pulse when it is active
+        // high and the end when it is active low, but either way a pulse has
+        // exactly one.
+        bool frame_start = computer->vsync && !vsync;
+        if(frame_start) {
+            ++frames;
+        }
+        vsync = computer->vsync;
+
+        // Display enable rises at the first visible dot of each line. Count
+        // the hsync edges while it is low: horizontal blank has one pulse and
+        // vertical blank many, whatever the sync polarity.
+        if(computer->hsync != hsync) { ++blank_hsync_edges; }
+        hsync = computer->hsync;
+        bool frame_line_start = computer->de && !de && (blank_hsync_edges > 4);
+        if(computer->de) { blank_hsync_edges = 0; }
+        de = computer->de;
+
+        if(options.trace_io && (computer->io_port != io_port)) {
+            std::printf("%llu: io_port=$%02x\n",
+                (unsigned long long)cycle, computer->io_port);
+        }
+        io_port = computer->io_port;
+        if(io_port == options.until_io) {
+            break;
+        }
+
+        if(options.boot_report) {
+            if(boot.init == 0) {
+                if(io_port == IO_BOOT_INIT) { boot.init = cycle; }
+            } else if(boot.display == 0) {
+                if(io_port == IO_BOOT_DISPLAY) { boot.display = cycle; }
+            } else if(frame_line_start) {
+                boot.line = cycle;
+                break;
+            }
+        }
+
+        int c = uart_receiver.tick(computer->uart_tx);
+        if(c >= 0) {
+            std::putchar(c);
+            std::fflush(stdout);
+        }
+    }
+
+    std::chrono::duration<double> wall =
+        std::chrono::steady_clock::now() - wall_start;
+
+    if(vcd) {
+        vcd->close();
+    }
+    computer->final();
+
+    double emulated = cycle / SYSTEM_CLOCK_HZ;
+    std::printf("cycles:        %llu\n", (unsigned long long)cycle);
+    std::printf("frames:        %llu\n", (unsigned long long)frames);
+    std::printf("emulated time: %.3f ms\n", emulated * 1e3);
+    std::printf("wall time:     %.3f s\n", wall.count());
+    std::printf("rate:          %.2f MHz (%.1f%% of real time)\n",
+        cycle / wall.count() / 1e6, 100.0 * emulated / wall.count());
+    std::printf("io_port:       $%02x\n", io_port);
+
+    if(options.boot_report) {
+        std::printf("boot: %-16s %llu cycles\n", "reset released",
+            (unsigned long long)RESET_CYCLES);
+        print_boot_time("init() entered", boot.init);
+        print_boot_time("screen drawn", boot.display);
+        print_boot_time("first line", boot.line);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,161 @@
+/**
+ * VGA frame grabber (simulation)
+ *
+ * Samples the RGB outputs once per dot and writes each complete frame to an
+ * ASCII PPM file along with a text file giving the measured timing. Capture is
+ * enabled by passing +capture=<prefix> to the simulator. Frames are written to
+ * <prefix>_<n>.ppm and <prefix>_<n>.txt. Passing +capture_frames=<n> finishes
+ * the simulation once n frames have been written.
+ *
+ * Timing is measured in dots and lines. de (display enable) marks the active
+ * picture and is used to learn the inactive level of each sync signal.
+ */
+module vga_capture(
+  input dot_clk,
+  input de,
+  input [3:0] r,
+  input [3:0] g,
+  input [3:0] b,
+  input hsync,
+  input vsync
+);
+
+parameter MAX_WIDTH = 1024;
+parameter MAX_HEIGHT = 768;
+
+reg [11:0] frame [0:MAX_WIDTH*MAX_HEIGHT-1];
+
+reg [4095:0] prefix;
+reg [4095:0] filename;
+reg enabled = 0;
+integer max_frames = 0;
+integer frame_index = 0;
+integer fd, px, py;
+reg [11:0] pixel;
+
+// Sync polarity
+reg polarity_known = 0;
+reg hsync_idle, vsync_idle;
+wire hsync_active = polarity_known && (hsync != hsync_idle);
+wire vsync_active = polarity_known && (vsync != vsync_idle);
+reg hsync_active_reg = 0, vsync_active_reg = 0, de_reg = 0;
+
+// Horizontal timing, counted in dots from the hsync leading edge
+integer dot = 0;
+integer line_dots = 0;
+integer hsync_dots = 0;
+integer h_front_porch = 0;
+integer de_end_dot = 0;
+
+// Vertical timing, counted in lines from the vsync leading edge
+integer line_count = 0;
+integer frame_lines = 0;
+integer vsync_lines = 0;
+integer v_front_porch = 0;
+integer last_active_line = 0;
+reg line_active = 0;
+reg started = 0;
+
+// Active picture
+integer x = 0, y = 0, width = 0;
+
+initial begin
+  if($value$plusargs("capture=%s", prefix)) begin
+    enabled = 1;
+  end
+  if(!$value$plusargs("capture_frames=%d", max_frames)) begin
+    max_frames = 0;
+  end
+end
+
+task write_frame;
+  begin
+    $sformat(filename, "%0s_%0d.ppm", prefix, frame_index);
+    fd = $fopen(filename, "w");
+    $fwrite(fd, "P3\n%0d %0d\n15\n", width, y);
+    for(py=0; py<y; py=py+1) begin
+      for(px=0; px<width; px=px+1) begin
+        pixel = frame[py*MAX_WIDTH + px];
+        $fwrite(fd, "%0d %0d %0d\n", pixel[11:8], pixel[7:4], pixel[3:0]);
+      end
+    end
+    $fclose(fd);
+
+    $sformat(filename, "%0s_%0d.txt", prefix, frame_index);
+    fd = $fopen(filename, "w");
+    $fwrite(fd, "active: %0dx%0d\n", width, y);
+    $fwrite(fd, "line: %0d dots\n", line_dots);
+    $fwrite(fd, "hsync: %0d dots, polarity %0d\n", hsync_dots, ~hsync_idle);
+    $fwrite(fd, "h front porch: %0d dots\n", h_front_porch);
+    $fwrite(fd, "frame: %0d lines\n", frame_lines);
+    $fwrite(fd, "vsync: %0d lines, polarity %0d\n", vsync_lines, ~vsync_idle);
+    $fwrite(fd, "v front porch: %0d lines\n", v_front_porch);
+    $fclose(fd);
+
+    $display("Captured frame %0d: %0dx%0d, line %0d dots, frame %0d lines",
+      frame_index, width, y, line_dots, frame_lines);
+  end
+endtask
+
+// All VDP outputs change on the rising edge of the dot clock.
+always @(negedge dot_clk) if(enabled) begin
+  if(de && ~polarity_known) begin
+    hsync_idle = hsync;
+    vsync_idle = vsync;
+    polarity_known = 1;
+  end
+
+  if(de) begin
+    if((x < MAX_WIDTH) && (y < MAX_HEIGHT)) begin
+      frame[y*MAX_WIDTH + x] = {r, g, b};
+    end
+    x = x + 1;
+    line_active = 1;
+  end else if(de_reg) begin
+    de_end_dot = dot;
+  end
+
+  if(hsync_active && ~hsync_active_reg) begin
+    line_dots = dot;
+    h_front_porch = dot - de_end_dot;
+    dot = 0;
+
+    if(line_active) begin
+      if(x > width) begin
+        width = x;
+      end
+      last_active_line = line_count;
+      y = y + 1;
+    end
+    line_active = 0;
+    x = 0;
+    line_count = line_count + 1;
+  end else if(~hsync_active && hsync_active_reg) begin
+    hsync_dots = dot;
+  end
+
+  if(vsync_active && ~vsync_active_reg) begin
+    if(started && (y > 0)) begin
+      frame_lines = line_count;
+      v_front_porch = line_count - last_active_line - 1;
+      write_frame;
+      frame_index = frame_index + 1;
+      if((max_frames > 0) && (frame_index >= max_frames)) begin
+        $finish;
+      end
+    end
+    started = 1;
+    line_count = 0;
+    y = 0;
+    width = 0;
+  end else if(~vsync_active && vsync_active_reg) begin
+    vsync_lines = line_count;
+  end
+
+  dot = dot + 1;
+  de_reg = de;
+  hsync_active_reg = hsync_active;
+  vsync_active_reg = vsync_active;
+end
+
+endmodule
@@ -0,0 +1,253 @@
+#!/usr/bin/env python3
+"""
+Compare the CPU cores which may be built into the computer.
+
+For each core the computer is synthesised with yosys and nextpnr, recording
+the LUTs used and the maximum frequency of the system clock, and the
+Verilator model is built and run with boot ROMs from os/bench:
+
+  test6502    the bc6502 processor test, which prints a line for each failure
+  bench       C runtime kernels, each timed in CPU cycles and checked, and the
+              average cycles taken by each multiply and divide routine
+  bench-soft  bench with the software multiply and divide routines, giving
+              the routine cycles without the multiply/divide unit
+
+The results are written as JSON to --report and summarised on stdout. The
+recommended core is the one which passes everything in the fewest kernel
+cycles. Fmax is reported but not used to choose: the CPU is clocked at 63MHz
+with RDY as a clock enable, so paths inside it have a whole CPU cycle, while
+nextpnr times every path against one system clock.
+
+The mul16, div16 and div32 kernels mostly time the multiply/divide unit
+(muldiv.v), which every core shares, rather than the core itself.
+
+Usage: cpu-bench.py [--cores CORE,...] [--no-synth] [--report FILE]
+
+Run from the root of the repository, usually via "make cpu-bench".
+"""
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+
+CORES = ['65c02', '6502', 'bc6502']
+BUILD_DIR = 'cpu-bench'
+SYSTEM_CLOCK_MHZ = 63.0
+
+# Kernels dominated by the shared multiply/divide unit
+MULDIV_KERNELS = ['mul16', 'div16', 'div32']
+
+# System clock cycles to simulate before giving up on a ROM
+MAX_CYCLES = 100000000
+
+ROMS = {
+    'test6502': 'os/bench/test6502.bin',
+    'bench': 'os/bench/bench.bin',
+    'bench-soft': 'os/bench/bench-soft.bin',
+}
+
+
+def make(*args):
+    subprocess.run(['make'] + list(args), check=True)
+
+
+def write_hex(binary, hex_path):
+    """Write a ROM image in the form read by bootrom.v."""
+    with open(binary, 'rb') as f:
+        data = f.read()
+    with open(hex_path, 'w') as f:
+        for byte in data:
+            f.write('{:02x}\n'.format(byte))
+
+
+def synthesise(core):
+    """Synthesise and place the computer, returning LUTs and Fmax."""
+    stem = os.path.join(BUILD_DIR, core, 'computer')
+    make('CPU_CORE=' + core, stem + '.tmp.asc')
+
+    result = {}
+
+    # The last statistics printed by synth_ice40 are for the final netlist.
+    with open(stem + '.yosys.log') as f:
+        luts = re.findall(r'^\s+SB_LUT4\s+(\d+)\s*$', f.read(), re.M)
+    if luts:
+        result['luts'] = int(luts[-1])
+
+    with open(stem + '.nextpnr.log') as f:
+        log = f.read()
+
+    cells = re.findall(r'ICESTORM_LC:\s+(\d+)/\s*(\d+)', log)
+    if cells:
+        result['logic_cells'] = int(cells[-1][0])
+
+    # nextpnr reports each clock before and after routing. Keep the last.
+    fmax = {}
+    for clock, mhz in re.findall(r"Max frequency for clock\s+'([^']+)':\s+([\d.]+) MHz", log):
+        fmax[clock] = float(mhz)
+    if fmax:
+        result['fmax_mhz'] = min(fmax.values())
+        result['fmax_by_clock_mhz'] = fmax
+
+    return result
+
+
+def simulate(core, rom):
+    """Run a boot ROM on the Verilator model until it sets the IO port to
+    $FF. Returns the lines sent to the UART, the CPU cycles taken and
+    whether the ROM finished."""
+    vsim_dir = os.path.join(BUILD_DIR, core, 'obj_dir')
+    vsim = os.path.join(vsim_dir, 'Vcomputer')
+    make('CPU_CORE=' + core, 'VSIM_DIR=' + vsim_dir, vsim)
+
+    hex_path = os.path.join(BUILD_DIR, rom + '.hex')
+    output = subprocess.run(
+        [vsim, '--until-io', '0xff', '--cycles', str(MAX_CYCLES),
+         '+bootrom=' + hex_path],
+        check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+
+    lines = [line.rstrip('\r') for line in output.splitlines()]
+    cycles = None
+    finished = False
+    for line in lines:
+        m = re.match(r'perf: cpu cycles\s+(\d+)', line)
+        if m:
+            cycles = int(m.group(1))
+        if re.match(r'io_port:\s+\$ff', line):
+            finished = True
+
+    uart = [line for line in lines
+            if not re.match(r'(perf: |cycles:|frames:|emulated time:|wall time:|rate:|io_port:)', line)]
+    return uart, cycles, finished
+
+
+def run_test6502(core):
+    uart, cycles, finished = simulate(core, 'test6502')
+    failures = [line for line in uart if line.endswith(':F')]
+    started = any(line == 'Testing Processor' for line in uart)
+    return {
+        'pass': finished and started and not failures,
+        'finished': finished,
+        'cpu_cycles': cycles,
+        'failures': failures,
+    }
+
+
+def parse_routines(uart):
+    routines = {}
+    for line in uart:
+        m = re.match(r'routine (\S+) cycles (\d+)$', line)
+        if m:
+            routines[m.group(1)] = int(m.group(2))
+    return routines
+
+
+def run_kernels(core):
+    uart, cycles, finished = simulate(core, 'bench')
+    kernels = {}
+    for line in uart:
+        m = re.match(r'kernel (\S+) cycles (\d+) (pass|fail)$', line)
+        if m:
+            kernels[m.group(1)] = {
+                'cpu_cycles': int(m.group(2)),
+                'pass': m.group(3) == 'pass',
+            }
+    return {
+        'pass': finished and bool(kernels) and all(k['pass'] for k in kernels.values()),
+        'finished': finished,
+        'cpu_cycles': sum(k['cpu_cycles'] for k in kernels.values()),
+        'kernels': kernels,
+        'routines': parse_routines(uart),
+    }
+
+
+def run_soft_routines(core):
+    uart, cycles, finished = simulate(core, 'bench-soft')
+    return parse_routines(uart) if finished else {}
+
+
+def recommend(results):
+    candidates = []
+    for core, result in results.items():
+        if not (result['test6502']['pass'] and result['bench']['pass']):
+            continue
+        synthesis = result.get('synthesis')
+        luts = synthesis.get('luts', 0) if synthesis else 0
+        candidates.append((result['bench']['cpu_cycles'], luts, core))
+    return min(candidates)[2] if candidates else None
+
+
+def summarise(results, best):
+    print('{:8} {:>6} {:>8} {:>10} {:>12}'.format(
+        'core', 'LUTs', 'Fmax', 'test6502', 'kernels'))
+    for core, result in results.items():
+        synthesis = result.get('synthesis') or {}
+        fmax = synthesis.get('fmax_mhz')
+        print('{:8} {:>6} {:>8} {:>10} {:>12}'.format(
+            core,
+            synthesis.get('luts', '-'),
+            '{:.1f}'.format(fmax) if fmax is not None else '-',
+            'pass' if result['test6502']['pass'] else 'FAIL',
+            result['bench']['cpu_cycles'] if result['bench']['pass'] else 'FAIL'))
+    print('recommended: {}'.format(best or 'none'))
+    print('Fmax is of the whole design against one system clock and is not')
+    print('used to choose. {} mostly time muldiv.v.'.format(
+        ', '.join(MULDIV_KERNELS)))
+
+    for core, result in results.items():
+        hardware = result['bench']['routines']
+        software = result['bench-soft']
+        print()
+        print('{}: average CPU cycles per operation'.format(core))
+        print('{:14} {:>9} {:>9}'.format('routine', 'software', 'hardware'))
+        for routine in sorted(set(hardware) | set(software)):
+            print('{:14} {:>9} {:>9}'.format(
+                routine, software.get(routine, '-'), hardware.get(routine, '-')))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare the CPU cores')
+    parser.add_argument('--cores', default=','.join(CORES),
+                        help='comma separated cores to compare')
+    parser.add_argument('--no-synth', action='store_true',
+                        help='skip synthesis')
+    parser.add_argument('--report', default='cpu-bench.json',
+                        help='JSON report to write')
+    args = parser.parse_args()
+
+    cores = args.cores.split(',')
+    for core in cores:
+        if core not in CORES:
+            sys.exit('unknown core {}'.format(core))
+        os.makedirs(os.path.join(BUILD_DIR, core), exist_ok=True)
+
+    make('-C', 'os', 'bench')
+    for rom, binary in ROMS.items():
+        write_hex(binary, os.path.join(BUILD_DIR, rom + '.hex'))
+
+    results = {}
+    for core in cores:
+        result = {}
+        if not args.no_synth:
+            result['synthesis'] = synthesise(core)
+        result['test6502'] = run_test6502(core)
+        result['bench'] = run_kernels(core)
+        result['bench-soft'] = run_soft_routines(core)
+        results[core] = result
+
+    best = recommend(results)
+    with open(args.report, 'w') as f:
+        json.dump({
+            'system_clock_mhz': SYSTEM_CLOCK_MHZ,
+            'muldiv_kernels': MULDIV_KERNELS,
+            'cores': results,
+            'recommended': best,
+        }, f, indent=2)
+        f.write('\n')
+
+    summarise(results, best)
+
+
+if __name__ == '__main__':
+    main()
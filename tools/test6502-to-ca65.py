@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""
+Convert the bc6502 processor test, bc6502/test6502.a65, to ca65 source which
+runs from the computer's boot ROM.
+
+The test prints "Testing Processor" and then a line ending ":F" for each
+instruction which fails. It is given a reset handler to stand in for the
+bc6502 boot strap and its UART is moved to the computer's. Rather than
+restarting from the reset vector when it is done, the converted test waits
+for the UART to send everything and writes $FF to the IO port.
+
+Usage: test6502-to-ca65.py INPUT OUTPUT
+"""
+import re
+import sys
+
+HEADER = """\
+; Generated from {source} by tools/test6502-to-ca65.py. Do not edit.
+.setcpu "6502"
+.include "uart.inc"
+
+IO_PORT = $8400
+
+.code
+
+test6502_reset:
+        sei
+        cld
+        ldx #$FF
+        txs
+"""
+
+FOOTER = """
+test6502_done:
+        lda #UART_TX_EMPTY      ; wait for the UART to send everything
+@wait:  bit UART_STATUS
+        beq @wait
+        lda #$FF
+        sta IO_PORT
+@halt:  jmp @halt
+
+.segment "VECTORS"
+
+.word test6502_reset    ; (reserved)
+.word test6502_reset    ; (reserved)
+.word test6502_reset    ; COP
+.word test6502_reset    ; (reserved)
+.word test6502_reset    ; ABORT
+.word test6502_reset    ; NMI
+.word test6502_reset    ; RESET
+.word test6502_reset    ; IRQ/BRK
+"""
+
+# Symbols moved to the computer's hardware
+SYMBOLS = {
+    'UART': 'UART_DATA',
+    'XMIT_FUL': 'UART_TX_FULL',
+}
+
+
+def convert_line(line):
+    code, sep, comment = line.partition(';')
+    code = code.rstrip()
+
+    if code == '':
+        return line.rstrip()
+
+    fields = code.split()
+
+    if line[0] not in ' \t':
+        # A label, an equate or a label before an instruction
+        if len(fields) >= 3 and fields[1].lower() == 'equ':
+            value = SYMBOLS.get(fields[0], ' '.join(fields[2:]))
+            code = '{} = {}'.format(fields[0], value)
+        else:
+            code = fields[0] + ':'
+            if len(fields) > 1:
+                code += ' ' + convert_statement(fields[1:])
+    elif fields[0].lower() == 'org':
+        # The linker places the code
+        code = ''
+    elif fields[0].lower() == 'jmp' and fields[1].upper() == '($FFFC)':
+        return '        jmp test6502_done'.ljust(32) + '; all tests run'
+    else:
+        code = '        ' + convert_statement(fields)
+
+    if sep:
+        code = code.ljust(32) + ';' + comment.rstrip()
+    return code.rstrip()
+
+
+def convert_statement(fields):
+    op = fields[0].lower()
+    if op == 'db':
+        op = '.byte'
+    # Strings may contain spaces so rejoin the operand as written
+    return '{} {}'.format(op, ' '.join(fields[1:])).rstrip()
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__.strip())
+
+    with open(sys.argv[1]) as f:
+        lines = f.read().splitlines()
+
+    with open(sys.argv[2], 'w') as f:
+        f.write(HEADER.format(source=sys.argv[1]))
+        for line in lines:
+            f.write(convert_line(line) + '\n')
+        f.write(FOOTER)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+"""
+Send a program to the UART loader in the boot ROM.
+
+The program is a raw binary which is loaded into the USR region at --addr and
+run from there. It is sent as a frame: "LD", the load address and length as
+little-endian 16 bit values, the program and the 16 bit sum of its bytes. The
+loader replies 'K' before running the program or 'E' if it rejects the frame.
+
+Usage: uart-load.py [--port PORT] [--baud BAUD] [--addr ADDR] [--monitor] PROGRAM
+       uart-load.py --frame FILE [--addr ADDR] PROGRAM
+
+--frame writes the frame to a file instead of sending it, for example to feed
+to the simulator. --monitor prints anything the program sends until
+interrupted.
+"""
+import argparse
+import struct
+import sys
+import time
+
+USR_START = 0x0400
+USR_END = 0x8000
+
+
+def make_frame(program, addr):
+    return (b'LD' + struct.pack('<HH', addr, len(program)) + program +
+            struct.pack('<H', sum(program) & 0xffff))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Send a program to the UART loader')
+    parser.add_argument('--port', default='/dev/ttyUSB1', help='serial port')
+    parser.add_argument('--baud', type=int, default=1000000, help='baud rate')
+    parser.add_argument('--addr', type=lambda s: int(s, 0), default=USR_START,
+                        help='load and run address')
+    parser.add_argument('--timeout', type=float, default=2.0,
+                        help='seconds to wait for a reply')
+    parser.add_argument('--frame', help='write the frame to this file instead of sending it')
+    parser.add_argument('--monitor', action='store_true',
+                        help='print output from the program after loading')
+    parser.add_argument('program', help='program binary')
+    args = parser.parse_args()
+
+    with open(args.program, 'rb') as f:
+        program = f.read()
+
+    if args.addr < USR_START or args.addr + len(program) > USR_END:
+        sys.exit('program does not fit in ${:04X}-${:04X}'.format(USR_START, USR_END - 1))
+
+    frame = make_frame(program, args.addr)
+
+    if args.frame is not None:
+        with open(args.frame, 'wb') as f:
+            f.write(frame)
+        return
+
+    import serial
+
+    with serial.Serial(args.port, args.baud, timeout=args.timeout) as port:
+        port.reset_input_buffer()
+        start = time.monotonic()
+        port.write(frame)
+        port.flush()
+        reply = port.read(1)
+        elapsed = time.monotonic() - start
+
+        if reply == b'E':
+            sys.exit('frame rejected')
+        elif reply != b'K':
+            sys.exit('no reply from loader')
+
+        print('loaded {} bytes at ${:04X} in {:.0f} ms'.format(
+            len(program), args.addr, elapsed * 1e3))
+
+        if args.monitor:
+            port.timeout = 0.1
+            try:
+                while True:
+                    data = port.read(256)
+                    if data:
+                        sys.stdout.write(data.decode('latin-1'))
+                        sys.stdout.flush()
+            except KeyboardInterrupt:
+                pass
+
+
+if __name__ == '__main__':
+    main()
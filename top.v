@@ -7,6 +7,9 @@ module top(
   output HSYNC,
   output VSYNC,
 
+  input UART_RX,
+  output UART_TX,
+
   output RGB0,
   output RGB1,
   output RGB2
@@ -21,6 +24,7 @@ pll pll(.clock_in(CLOCK_12M), .clock_out(clk));
 computer computer(
   .clk(clk),
   .io_port(io_port),
+  .uart_rx(UART_RX), .uart_tx(UART_TX),
   .r(R), .g(G), .b(B),
   .hsync(HSYNC), .vsync(VSYNC)
 );
@@ -0,0 +1,113 @@
+// UART
+//
+// The bc6502 UART (bc6502/bc_uart.v), a serial port with 16 byte receive and
+// transmit FIFOs, each holding up to 15 characters. Characters are eight data
+// bits, no parity and one stop bit. The registers are as described in
+// bc_uart.v:
+//
+//   0  read: next received byte, removing it from the FIFO
+//      write: queue a byte to transmit
+//   1  read: {irq, rx ready, rx full, tx empty, tx full, 2'b0, cts}
+//   2  control: {1'b0, rx ready irq enable, rx full irq enable, tx empty irq
+//      enable, 2'b0, rts, 1'b0}
+//   3  read: {overrun, frame error, 6'b0}
+//      write: empty both FIFOs and clear overrun
+//   4  baud clock multiplier, high byte
+//   5  baud clock multiplier, low byte
+//
+// The baud rate is clk * multiplier / 2**20. bc_uart resets the multiplier to
+// 1007, for 19200 baud from 20MHz, so this wrapper writes BAUD_MUL to it on
+// the clocks after reset. The default gives 1 Mbaud from the 63MHz clock;
+// 49932 gives 3 Mbaud.
+//
+// The wrapper presents bc_uart to the computer's bus. Each access is taken on
+// the first clock of its strobe, whatever its length, and read data is
+// registered then, before the receive FIFO moves on.
+
+// bc_uart names ports "do", which is a SystemVerilog keyword.
+`ifndef SYNTHESIS
+`begin_keywords "1364-2005"
+`endif
+`include "bc6502/bc_uart.v"
+`include "bc6502/bc_uart_rx.v"
+`include "bc6502/bc_uart_tx.v"
+`include "bc6502/lib/bc_fifo16x8.v"
+`ifndef SYNTHESIS
+`end_keywords
+`endif
+
+module uart(
+  input reset,
+  input clk,
+
+  input [2:0] addr,
+  input read,
+  input write,
+  input [7:0] data_in,
+  output reg [7:0] data_out,
+
+  input rx,
+  output tx
+);
+
+parameter [15:0] BAUD_MUL = 16644;
+
+reg write_reg;
+reg read_reg;
+wire read_start = read && ~read_reg;
+wire write_start = write && ~write_reg;
+
+// Writes of the baud clock multiplier after reset, high byte first
+reg [1:0] init_state;
+wire init = init_state != 2;
+
+// bc_uart's transmit shift register is not reset so the line is held idle
+// until the first byte is queued.
+reg tx_started;
+wire uart_tx;
+assign tx = tx_started ? uart_tx : 1'b1;
+
+wire [7:0] uart_data_out;
+
+bc_uart uart(
+  .reset(reset),
+  .clk(clk),
+  .ce(1'b1),
+  .cs(1'b1),
+  .rd(read_start),
+  .wr(init || write_start),
+  .a(init ? {2'b10, init_state[0]} : addr),
+  .di(init ? (init_state[0] ? BAUD_MUL[7:0] : BAUD_MUL[15:8]) : data_in),
+  .do(uart_data_out),
+  .irq(),
+  .cts(1'b0),
+  .rts(),
+  .sin(rx),
+  .sout(uart_tx)
+);
+
+always @(posedge clk) begin
+  if(reset) begin
+    write_reg <= 0;
+    read_reg <= 0;
+    init_state <= 0;
+    tx_started <= 0;
+  end else begin
+    write_reg <= write;
+    read_reg <= read;
+
+    if(init) begin
+      init_state <= init_state + 1;
+    end
+
+    if(write_start && (addr == 0)) begin
+      tx_started <= 1;
+    end
+
+    if(read_start) begin
+      data_out <= uart_data_out;
+    end
+  end
+end
+
+endmodule
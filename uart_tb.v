@@ -0,0 +1,234 @@
+`timescale 1ns/100ps
+
+module testbench;
+  // 63MHz clock
+  reg clk = 1;
+  always #(1000.0 / (63*2)) clk = ~clk;
+
+  // Derive CPU clock from system clock
+  parameter CPU_DIV_W = 2;
+  reg [CPU_DIV_W-1:0] cpu_clk_ctr = 0;
+  wire cpu_clk = cpu_clk_ctr[CPU_DIV_W-1];
+  always @(posedge clk) cpu_clk_ctr = cpu_clk_ctr + 1;
+
+  // Serial line timing. The UART's default BAUD_MUL gives 63 clocks per bit.
+  parameter BIT_CLOCKS = 63;
+
+  // UART interface
+  reg reset = 0;
+  reg [2:0] addr = 0;
+  reg read = 0;
+  reg write = 0;
+  reg [7:0] data_in = 0;
+  wire [7:0] data_out;
+
+  // Stand-in for the serial line. rx is driven by serial_send and tx is
+  // decoded by the receiver below.
+  reg rx = 1;
+  wire tx;
+
+  // Reads and writes are strobed while cpu_clk is low. computer.v strobes each
+  // access for only the clock before the end of the CPU cycle and peripherals
+  // must behave the same for either.
+  uart uart(
+    .clk(clk),
+    .reset(reset),
+
+    .addr(addr),
+    .read(read && ~cpu_clk),
+    .write(write && ~cpu_clk),
+    .data_in(data_in),
+    .data_out(data_out),
+
+    .rx(rx),
+    .tx(tx)
+  );
+
+  integer errors = 0;
+
+  task cpu_write(input [2:0] write_addr, input [7:0] value);
+    begin
+      addr = write_addr;
+      data_in = value;
+      write = 1;
+      @(posedge cpu_clk);
+      @(negedge cpu_clk);
+      write = 0;
+    end
+  endtask
+
+  task cpu_read(input [2:0] read_addr, output [7:0] value);
+    begin
+      addr = read_addr;
+      read = 1;
+      @(posedge cpu_clk);
+      value = data_out;
+      @(negedge cpu_clk);
+      read = 0;
+    end
+  endtask
+
+  // Send a character down the serial line: start bit, eight data bits LSB
+  // first and a stop bit.
+  task serial_send(input [7:0] value);
+    integer i;
+    begin
+      rx = 0;
+      repeat (BIT_CLOCKS) @(posedge clk);
+      for(i=0; i<8; i=i+1) begin
+        rx = value[i];
+        repeat (BIT_CLOCKS) @(posedge clk);
+      end
+      rx = 1;
+      repeat (BIT_CLOCKS) @(posedge clk);
+    end
+  endtask
+
+  // Decode characters sent by the UART, sampling the middle of each bit.
+  reg [7:0] tx_received [0:255];
+  integer tx_received_count = 0;
+
+  initial begin : serial_receive
+    integer i;
+    reg [7:0] value;
+    forever begin
+      @(negedge tx);
+      repeat (BIT_CLOCKS / 2) @(posedge clk);
+      if(tx == 0) begin
+        for(i=0; i<8; i=i+1) begin
+          repeat (BIT_CLOCKS) @(posedge clk);
+          value[i] = tx;
+        end
+        repeat (BIT_CLOCKS) @(posedge clk);
+        if(tx != 1) begin
+          $display("ERROR: no stop bit after $%02x from UART", value);
+          errors = errors + 1;
+        end
+        tx_received[tx_received_count] = value;
+        tx_received_count = tx_received_count + 1;
+      end
+    end
+  end
+
+  task expect_reg(input [2:0] read_addr, input [7:0] mask, input [7:0] expected);
+    reg [7:0] value;
+    begin
+      cpu_read(read_addr, value);
+      if((value & mask) !== expected) begin
+        $display("ERROR: register %0d $%02x, expected $%02x under mask $%02x",
+          read_addr, value, expected, mask);
+        errors = errors + 1;
+      end
+    end
+  endtask
+
+  // Status is {irq, rx ready, rx full, tx empty, tx full, 2'b0, cts} and the
+  // error register is {overrun, frame error, 6'b0}.
+  task expect_status(input [7:0] mask, input [7:0] expected);
+    expect_reg(1, mask, expected);
+  endtask
+
+  task expect_errors(input [7:0] mask, input [7:0] expected);
+    expect_reg(3, mask, expected);
+  endtask
+
+  task expect_byte(input [7:0] expected);
+    reg [7:0] value;
+    begin
+      cpu_read(0, value);
+      if(value != expected) begin
+        $display("ERROR: received $%02x, expected $%02x", value, expected);
+        errors = errors + 1;
+      end
+    end
+  endtask
+
+  reg [4095:0] vcdfile;
+
+  initial begin
+    if ($value$plusargs("vcd=%s", vcdfile)) begin
+      $dumpfile(vcdfile);
+      $dumpvars(0, testbench);
+    end
+  end
+
+  integer n;
+
+  initial begin
+    reset = 1;
+    repeat (10) @(posedge cpu_clk);
+    reset = 0;
+    repeat (1) @(negedge cpu_clk);
+
+    // The baud clock multiplier is set after reset
+    expect_status(8'hf8, 8'h10);
+    expect_reg(5, 8'hff, 8'h04);
+
+    // Receive a few characters
+    serial_send(8'h4c);
+    serial_send(8'h44);
+    serial_send(8'h00);
+    serial_send(8'hff);
+    repeat (10) @(posedge clk);
+    expect_status(8'h40, 8'h40);
+    expect_byte(8'h4c);
+    expect_byte(8'h44);
+    expect_byte(8'h00);
+    expect_byte(8'hff);
+    expect_status(8'h60, 8'h00);
+    expect_errors(8'hc0, 8'h00);
+
+    // Overflow the receive FIFO, which holds 15 characters. The characters
+    // which do not fit are lost.
+    for(n=0; n<20; n=n+1) begin
+      serial_send(n);
+    end
+    repeat (10) @(posedge clk);
+    expect_status(8'h60, 8'h60);
+    expect_errors(8'h80, 8'h80);
+    for(n=0; n<15; n=n+1) begin
+      expect_byte(n);
+    end
+    expect_status(8'h40, 8'h00);
+    cpu_write(3, 8'h00);
+    expect_errors(8'h80, 8'h00);
+
+    // A character without a stop bit is a framing error. It is still
+    // received. The line is released before the receiver would take it as
+    // another start bit.
+    rx = 0;
+    repeat (BIT_CLOCKS * 39 / 4) @(posedge clk);
+    rx = 1;
+    repeat (BIT_CLOCKS * 2) @(posedge clk);
+    expect_errors(8'h40, 8'h40);
+    expect_status(8'h40, 8'h40);
+    expect_byte(8'h00);
+
+    // Transmit, filling the FIFO faster than it drains
+    for(n=0; n<15; n=n+1) begin
+      cpu_write(0, 8'ha0 + n);
+    end
+    expect_status(8'h10, 8'h00);
+    repeat (BIT_CLOCKS * 10 * 17) @(posedge clk);
+    expect_status(8'h18, 8'h10);
+
+    if(tx_received_count != 15) begin
+      $display("ERROR: UART sent %0d characters, expected 15", tx_received_count);
+      errors = errors + 1;
+    end
+    for(n=0; n<tx_received_count; n=n+1) begin
+      if(tx_received[n] != 8'ha0 + n) begin
+        $display("ERROR: UART sent $%02x, expected $%02x", tx_received[n], 8'ha0 + n);
+        errors = errors + 1;
+      end
+    end
+
+    if(errors == 0) begin
+      $display("All UART checks passed");
+    end else begin
+      $display("%0d UART checks failed", errors);
+    end
+
+    $finish;
+  end
+endmodule
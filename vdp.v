@@ -9,12 +9,19 @@ module vdp (
   output [7:0] data_out,
 
   output rdy,
+  output irq,
+
+  // Single clock pulses for each CPU write reaching VRAM and at the start of
+  // each vertical blank.
+  output vram_write_done,
+  output vblank_start,
 
   output [3:0] r,
   output [3:0] g,
   output [3:0] b,
   output reg hsync,
-  output reg vsync
+  output reg vsync,
+  output de         // high while visible dots are output
 );
 
 // Registers
@@ -39,26 +46,183 @@ reg [3:0]   v_sync_chars;
 
 reg [7:0]   h_chars;
 
+// Scrolling. The name and attribute tables form a virtual screen of h_chars
+// columns by v_rows rows (0 => 256) which wraps in both directions.
+reg [7:0]   scroll_x_chars;
+reg [2:0]   scroll_x_dots;
+reg [7:0]   scroll_y_rows;
+reg [3:0]   scroll_y_lines;
+reg [7:0]   v_rows;
+
+// Character patterns are fetched from the character ROM rather than the
+// pattern table in VRAM if set.
+reg         pattern_rom;
+
+// Sprites. Each is an 8x8 pattern from the sprite pattern table drawn in one
+// colour over the characters. Like characters, each pattern row is two lines
+// high. Sprite n is set by registers 64+4n to 67+4n:
+//
+//   0  X[7:0], in dots from the left of the display
+//   1  Y[7:0], in lines from the top of the display
+//   2  {enable, Y[8], X[9:8], colour}
+//   3  pattern number
+//
+// Lower numbered sprites are drawn in front. Clear pattern bits are
+// transparent.
+localparam  SPRITES = 8;
+
+reg [15:0]  sprite_pattern_base;
+reg [9:0]   sprite_x [0:SPRITES-1];
+reg [8:0]   sprite_y [0:SPRITES-1];
+reg         sprite_enable [0:SPRITES-1];
+reg [3:0]   sprite_colour [0:SPRITES-1];
+reg [7:0]   sprite_pattern [0:SPRITES-1];
+
+// Each sprite's pattern row for the next line is fetched into its line buffer
+// during horizontal blank, using slot 1 of the memory schedule. The fetch takes up
+// to the first five characters of the blank, which must be at least six
+// characters long.
+reg         sprite_hv_reg;
+reg         sprite_fetching;
+reg [2:0]   sprite_fetch_index;
+reg         sprite_fetch_pending;
+reg [2:0]   sprite_fetch_latch;
+reg         sprite_fetch_hit;
+reg [7:0]   sprite_line [0:SPRITES-1];
+integer     sprite_i;
+
 reg rdy;
 
 // CPU <-> register interface
 reg write_reg;
+reg read_reg;
 reg [1:0] mode_reg;
 
 // CPU <-> VRAM interface
 reg [7:0]   vram_data_to_write;
 reg [7:0]   vram_data_read;
-reg         vram_write_request;
-reg         vram_write_acknowledge;
 
-// VRAM interface
-reg [15:0] vram_offset;
-reg [15:0] vram_base;
-wire [7:0] vram_data_out;
-reg [7:0] vram_data;
+// VRAM read-ahead. vram_data_read is refilled from read_address in the CPU
+// slot whenever no writes are queued. read_valid is cleared whenever the data
+// at read_address may have changed and set when a fetch completes unless it
+// was issued before the last such change, which read_stale records.
+reg         read_valid;
+reg         read_in_flight;
+reg         read_stale;
+wire        read_fetch_issued;
+wire        read_fetch_done;
+wire        read_advance = ~read && read_reg && (mode_reg == 2) && rdy;
+wire        read_invalidate;
+
+// VRAM write FIFO. CPU writes to VRAM data are queued here and drained by the
+// memory scheduler. The write address is incremented as each entry drains.
+localparam  WRITE_FIFO_ADDR_W = 3; // 8 entries
+
+reg [7:0]   write_fifo [0:(1<<WRITE_FIFO_ADDR_W)-1];
+reg [WRITE_FIFO_ADDR_W-1:0] write_fifo_head;
+reg [WRITE_FIFO_ADDR_W-1:0] write_fifo_tail;
+reg [WRITE_FIFO_ADDR_W:0]   write_fifo_count;
+wire        write_fifo_empty = write_fifo_count == 0;
+wire        write_fifo_full = write_fifo_count[WRITE_FIFO_ADDR_W];
+wire        write_fifo_push = ~write && write_reg && (mode_reg == 2) && rdy;
+wire        write_fifo_pop;
+
+// Block fill/copy engine. Parameters and command are written by the CPU. The
+// engine runs in the memory scheduler using slots not needed by the CPU or
+// display.
+localparam  ENGINE_FILL = 2'd1;
+localparam  ENGINE_COPY = 2'd2;
+
+reg [15:0]  engine_src;
+reg [15:0]  engine_dst;
+reg [15:0]  engine_length;
+reg [7:0]   engine_fill_value;
+reg [1:0]   engine_command;
+reg         engine_start;         // toggled by each command write
+reg         engine_start_ack;     // follows engine_start once command is taken
+
+reg [15:0]  engine_src_ctr;
+reg [15:0]  engine_dst_ctr;
+reg [15:0]  engine_remaining;
+reg         engine_copy;
+reg         engine_busy;
+reg         engine_have_data;     // copy has read a byte yet to be written
+reg         engine_read_pending;  // copy read is in flight this slot
+reg [7:0]   engine_data;
+
+wire        engine_status_busy = engine_busy || (engine_start != engine_start_ack);
+reg         engine_status_busy_reg;
+wire        engine_done = engine_status_busy_reg && ~engine_status_busy;
+
+// The read-ahead is refetched after each VRAM data read, after any write to
+// VRAM by the CPU, when the block engine finishes and when the read address
+// is set.
+assign read_invalidate = read_advance || write_fifo_pop || engine_done ||
+  (write && (mode == 1) && ((reg_address == 0) || (reg_address == 1)));
+
+// Interrupts. Vertical blank and line compare interrupts are latched in the
+// status register and acknowledged by writing a 1 to the corresponding bit.
+reg [1:0]   irq_enable;           // {line, vblank}
+reg [10:0]  line_compare;
+reg         vblank_pending;
+reg         line_pending;
+reg         v_visible_reg;
+reg         line_match_reg;
+
+assign irq = (vblank_pending && irq_enable[0]) || (line_pending && irq_enable[1]);
+
+// Status register, read via mode 3
+wire [7:0]  status = {
+  write_fifo_full, engine_status_busy, vblank_pending, line_pending,
+  write_fifo_count
+};
+
+assign data_out = (mode == 3) ? status : (mode == 2) ? vram_data_read : 8'h00;
+
+// VRAM interface. The 64K of VRAM is split across two SPRAM blocks by
+// address bit 15, $0000-$7FFF in vram_low and $8000-$FFFF in vram_high. In
+// each memory slot one block may serve a display fetch while the other serves
+// the CPU port: the write FIFO, the read-ahead or the block engine. With the
+// name and attribute tables in one block and patterns in the other, or from
+// the character ROM, the port has at least six of every eight slots.
+reg [14:0]  vram_low_addr;
+reg         vram_low_write_enable;
+reg [7:0]   vram_low_data_in;
+wire [7:0]  vram_low_data_out;
+reg [14:0]  vram_high_addr;
+reg         vram_high_write_enable;
+reg [7:0]   vram_high_data_in;
+wire [7:0]  vram_high_data_out;
+
+// Block read by the last display fetch and CPU port access
+reg         display_bank;
+reg         port_bank;
+wire [7:0]  display_data_out = display_bank ? vram_high_data_out : vram_low_data_out;
+wire [7:0]  port_data_out = port_bank ? vram_high_data_out : vram_low_data_out;
 
 reg [1:0] mem_state;
-reg vram_write_enable;
+
+// Accesses chosen for the current slot
+reg         display_access;
+reg [15:0]  display_addr;
+reg         port_access;
+reg         port_write;
+reg [15:0]  port_addr;
+reg [7:0]   port_data;
+reg [15:0]  engine_addr;
+
+// The next character is fetched in slots 1 to 3 of the first round of slots
+// after the character starts. The other round is free for the CPU port.
+reg         display_fetch;
+
+// Character ROM interface
+reg [10:0]  charrom_addr;
+wire [7:0]  charrom_data;
+reg         pattern_from_rom;
+reg vram_fifo_write_toggle; // toggled as each write drains the write FIFO
+reg vram_cpu_read;          // current read is for read_address
+reg vram_read_issue_toggle; // toggled as each read-ahead fetch is issued
+reg vram_read_done_toggle;  // toggled as each read-ahead fetch is latched
 
 // Horizontal timing
 reg [7:0]   h_ctr;
@@ -72,10 +236,37 @@ reg [3:0]   v_sync_ctr;
 reg         v_sync_active;
 reg         v_visible;
 
+// Characters are fetched on visible lines from the last character of
+// horizontal blank onwards.
+wire        line_fetch = v_visible &&
+                         (h_visible || (h_ctr == h_blank_chars));
+
+wire        line_match = v_visible && (v_ctr == line_compare);
+
+// During horizontal blank v_ctr is the next line. The sprite being fetched is
+// on it if it starts no more than 15 lines above.
+wire [9:0]  sprite_fetch_dy = v_ctr[9:0] - {1'b0, sprite_y[sprite_fetch_index]};
+wire        sprite_fetch_on_line = sprite_enable[sprite_fetch_index] &&
+                                   (sprite_fetch_dy[9:4] == 0);
+assign      vblank_start = v_visible_reg && ~v_visible;
+
 // Character addressing
 reg [15:0]  char_addr;
 reg [3:0]   char_row;
 reg [15:0]  start_char_addr;
+reg [7:0]   char_col;
+reg [7:0]   text_row;
+
+// Name table offset of the first scrolled row, computed during vertical blank
+reg [15:0]  scroll_row_addr;
+reg [7:0]   scroll_row_ctr;
+reg [7:0]   scroll_row_first;
+
+// A fine horizontal scroll shows the tail of the first character. That
+// character is skipped and the rest of the line delayed to make room for it.
+wire [7:0]  scroll_first_col =
+  (scroll_x_dots == 0) ? scroll_x_chars :
+  ((scroll_x_chars + 8'd1) == h_chars) ? 8'd0 : (scroll_x_chars + 8'd1);
 
 // Character rendering
 reg [15:0]  line_start_char_offset;
@@ -89,6 +280,18 @@ reg [7:0]   char_attrs;
 
 // Output pixel generation
 reg         visible;
+reg [2:0]   char_state;
+reg         hv_reg;
+
+// Sprite rendering. line_dot counts dots from the left of the display. Each
+// sprite's line buffer is shifted out from the dot at its X position.
+reg         line_started;
+reg [10:0]  line_dot;
+reg [7:0]   sprite_shift [0:SPRITES-1];
+reg [3:0]   sprite_px;
+reg         sprite_px_set;
+integer     sprite_j;
+integer     sprite_k;
 
 reg [3:0]   clock_ctr = 0;
 wire        dot_clk = ~clock_ctr[0];
@@ -105,9 +308,32 @@ end
 
 wire [3:0]  px_colour;
 
-assign r = visible ? {px_colour[3], px_colour[0], px_colour[3] && px_colour[0], px_colour[3] && px_colour[0]} : 4'h0;
-assign g = visible ? {px_colour[3], px_colour[1], px_colour[3] && px_colour[1], px_colour[3] && px_colour[1]} : 4'h0;
-assign b = visible ? {px_colour[3], px_colour[2], px_colour[3] && px_colour[2], px_colour[3] && px_colour[2]} : 4'h0;
+// Fine horizontal scroll delays the pixel stream by up to seven dots. Dots
+// delayed from outside the visible area are black so the partially scrolled
+// first column is blanked.
+reg [27:0]  px_history;
+wire [2:0]  px_delay = 3'd0 - scroll_x_dots;
+wire [3:0]  px_out = (px_delay == 0) ? px_colour : px_history[px_delay*4-1 -: 4];
+
+// Sprites are drawn over the characters after the fine scroll so that they
+// stay put as the characters scroll.
+always @* begin
+  sprite_px = 4'h0;
+  sprite_px_set = 0;
+  for(sprite_k=SPRITES-1; sprite_k>=0; sprite_k=sprite_k-1) begin
+    if(sprite_shift[sprite_k][7]) begin
+      sprite_px = sprite_colour[sprite_k];
+      sprite_px_set = 1;
+    end
+  end
+end
+
+wire [3:0]  px = sprite_px_set ? sprite_px : px_out;
+
+assign r = visible ? {px[3], px[0], px[3] && px[0], px[3] && px[0]} : 4'h0;
+assign g = visible ? {px[3], px[1], px[3] && px[1], px[3] && px[1]} : 4'h0;
+assign b = visible ? {px[3], px[2], px[3] && px[2], px[3] && px[2]} : 4'h0;
+assign de = visible;
 
 // Character dot counter
 always @(posedge clk) begin
@@ -117,7 +343,9 @@ end
 // CPU read/write
 always @(posedge clk) begin
   if(reset) begin
-    vram_write_request <= 1'b0;
+    write_fifo_head <= 0;
+    write_fifo_tail <= 0;
+    write_fifo_count <= 0;
 
     reg_address <= 0;
     read_address <= 0;
@@ -140,8 +368,35 @@ always @(posedge clk) begin
 
     h_chars <= 8'd40;
 
+    scroll_x_chars <= 0;
+    scroll_x_dots <= 0;
+    scroll_y_rows <= 0;
+    scroll_y_lines <= 0;
+    v_rows <= 0;
+    pattern_rom <= 1;
+
+    sprite_pattern_base <= 0;
+    for(sprite_i=0; sprite_i<SPRITES; sprite_i=sprite_i+1) begin
+      sprite_enable[sprite_i] <= 0;
+    end
+
+    engine_command <= 0;
+    engine_start <= 0;
+
+    irq_enable <= 0;
+    line_compare <= 0;
+    vblank_pending <= 0;
+    line_pending <= 0;
+    v_visible_reg <= 1;
+    line_match_reg <= 0;
+
     write_reg <= 0;
+    read_reg <= 0;
     mode_reg <= 0;
+    read_valid <= 0;
+    read_in_flight <= 0;
+    read_stale <= 0;
+    engine_status_busy_reg <= 0;
 
     rdy <= 1;
   end else begin
@@ -155,8 +410,8 @@ always @(posedge clk) begin
           case(reg_address)
             0: read_address[7:0] <= data_in;
             1: read_address[15:8] <= data_in;
-            2: write_address[7:0] <= data_in;
-            3: write_address[15:8] <= data_in;
+            2: if(write_fifo_empty) write_address[7:0] <= data_in;
+            3: if(write_fifo_empty) write_address[15:8] <= data_in;
             4: h_display_chars <= data_in;
             5: h_blank_chars <= data_in;
             6: {h_sync_polarity, h_front_porch_chars} <= data_in;
@@ -171,7 +426,39 @@ always @(posedge clk) begin
             15: attr_table_base[7:0] <= data_in;
             16: attr_table_base[15:8] <= data_in;
             17: h_chars <= data_in;
+            18: engine_src[7:0] <= data_in;
+            19: engine_src[15:8] <= data_in;
+            20: engine_dst[7:0] <= data_in;
+            21: engine_dst[15:8] <= data_in;
+            22: engine_length[7:0] <= data_in;
+            23: engine_length[15:8] <= data_in;
+            24: engine_fill_value <= data_in;
+            25: engine_command <= data_in[1:0];
+            26: irq_enable <= data_in[1:0];
+            27: line_compare[7:0] <= data_in;
+            28: line_compare[10:8] <= data_in[2:0];
+            29: scroll_x_chars <= data_in;
+            30: scroll_y_rows <= data_in;
+            31: {scroll_y_lines, scroll_x_dots} <= {data_in[7:4], data_in[2:0]};
+            32: v_rows <= data_in;
+            33: pattern_rom <= data_in[0];
+            34: sprite_pattern_base[7:0] <= data_in;
+            35: sprite_pattern_base[15:8] <= data_in;
           endcase
+
+          if(reg_address[7:5] == 3'b010) begin
+            case(reg_address[1:0])
+              0: sprite_x[reg_address[4:2]][7:0] <= data_in;
+              1: sprite_y[reg_address[4:2]][7:0] <= data_in;
+              2: begin
+                sprite_enable[reg_address[4:2]] <= data_in[7];
+                sprite_y[reg_address[4:2]][8] <= data_in[6];
+                sprite_x[reg_address[4:2]][9:8] <= data_in[5:4];
+                sprite_colour[reg_address[4:2]] <= data_in[3:0];
+              end
+              3: sprite_pattern[reg_address[4:2]] <= data_in;
+            endcase
+          end
         end
 
         2: begin
@@ -180,89 +467,317 @@ always @(posedge clk) begin
       endcase
     end
 
-    // If we're still waiting for a VRAM write request to complete, don't allow
-    // another.
-    rdy <= ~write || (mode != 2) || ~vram_write_request;
+    // Stall the CPU if it writes VRAM data while the write FIFO is full, if
+    // it moves the write address while queued writes are pending or if it
+    // reads VRAM data before the read-ahead is valid. This is decided once at
+    // the start of each access so that RDY is stable when the CPU samples it.
+    if(write && ~write_reg) begin
+      rdy <= ~(
+        ((mode == 2) && write_fifo_full) ||
+        ((mode == 1) && ((reg_address == 2) || (reg_address == 3)) && ~write_fifo_empty)
+      );
+    end else if(read && ~read_reg) begin
+      rdy <= ~((mode == 2) && ~read_valid);
+    end else if(~write && ~read) begin
+      rdy <= 1;
+    end
+
+    // Advance the read address after each VRAM data read.
+    if(read_advance) begin
+      read_address <= read_address + 1;
+    end
+
+    if(read_invalidate) begin
+      read_valid <= 0;
+    end else if(read_fetch_done) begin
+      read_valid <= ~read_stale;
+    end
+
+    if(read_fetch_issued) begin
+      read_in_flight <= 1;
+      read_stale <= read_invalidate;
+    end else begin
+      if(read_fetch_done) begin
+        read_in_flight <= 0;
+      end
+      if(read_invalidate) begin
+        read_stale <= 1;
+      end
+    end
+    engine_status_busy_reg <= engine_status_busy;
 
-    if(~write && write_reg && (mode_reg == 2)) begin
-      vram_write_request <= 1;
-    end else if(vram_write_request && vram_write_acknowledge) begin
-      vram_write_request <= 0;
+    if(write_fifo_push) begin
+      write_fifo[write_fifo_head] <= vram_data_to_write;
+      write_fifo_head <= write_fifo_head + 1;
+    end
+
+    if(write_fifo_pop) begin
+      write_fifo_tail <= write_fifo_tail + 1;
       write_address <= write_address + 1;
     end
 
+    case({write_fifo_push, write_fifo_pop})
+      2'b10: write_fifo_count <= write_fifo_count + 1;
+      2'b01: write_fifo_count <= write_fifo_count - 1;
+    endcase
+
+    // Vertical blank starts when the display leaves the last visible line. The
+    // line compare matches from the horizontal blank before the line.
+    v_visible_reg <= v_visible;
+    line_match_reg <= line_match;
+
+    if(vblank_start) begin
+      vblank_pending <= 1;
+    end else if(write && (mode == 3) && data_in[5]) begin
+      vblank_pending <= 0;
+    end
+
+    if(~line_match_reg && line_match) begin
+      line_pending <= 1;
+    end else if(write && (mode == 3) && data_in[4]) begin
+      line_pending <= 0;
+    end
+
+    // Start the block engine once the command register write completes.
+    if(~write && write_reg && (mode_reg == 1) && (reg_address == 25)) begin
+      engine_start <= ~engine_start;
+    end
+
     write_reg <= write;
+    read_reg <= read;
     mode_reg <= mode;
   end
 end
 
 always @(posedge dot_clk) if (reset) begin
-  mem_state <= 0;
-  vram_base <= 0;
-  vram_offset <= 0;
-  vram_write_enable <= 0;
+  mem_state = 0;
+  vram_low_write_enable <= 0;
+  vram_high_write_enable <= 0;
+  display_fetch <= 0;
+  vram_fifo_write_toggle <= 0;
+  vram_cpu_read <= 0;
+  vram_read_issue_toggle <= 0;
+  vram_read_done_toggle <= 0;
+
+  engine_start_ack <= 0;
+  engine_busy <= 0;
+  engine_have_data <= 0;
+  engine_read_pending <= 0;
+
+  sprite_hv_reg <= 0;
+  sprite_fetching <= 0;
+  sprite_fetch_index <= 0;
+  sprite_fetch_pending <= 0;
 end else begin
   mem_state = mem_state + 1;
 
+  // Latch data read in the previous slot.
   case(mem_state)
-    0: begin
-      next_char_pattern <= vram_data_out;
-      vram_base <= 16'h0000;
-      vram_offset <= vram_write_request ? write_address : read_address;
-      vram_write_enable <= vram_write_request;
+    0: if(display_fetch) begin
+      next_char_pattern <= pattern_from_rom ? charrom_data : display_data_out;
+    end
+    2: if(sprite_fetch_pending) begin
+      sprite_line[sprite_fetch_latch] <= sprite_fetch_hit ? display_data_out : 8'h00;
+    end else if(display_fetch) begin
+      next_char_attrs <= display_data_out;
     end
+  endcase
+
+  if(vram_cpu_read) begin
+    vram_data_read <= port_data_out;
+    vram_read_done_toggle <= ~vram_read_done_toggle;
+  end
+
+  if(engine_read_pending) begin
+    engine_data <= port_data_out;
+  end
+
+  // Display fetches. Characters are fetched from the last character of
+  // horizontal blank, ahead of the first visible one, to the end of the line.
+  // Patterns are not fetched from VRAM while they come from the character
+  // ROM. Sprite patterns take slot 1 while they are fetched during horizontal
+  // blank.
+  display_access = 0;
+  display_addr = 16'h0000;
+  sprite_fetch_pending <= 0;
+
+  case(mem_state)
     1: begin
-      if(~vram_write_enable) begin
-        vram_data_read <= vram_data_out;
+      if(sprite_fetching) begin
+        display_access = 1;
+        display_addr = sprite_pattern_base +
+          {5'b0, sprite_pattern[sprite_fetch_index], sprite_fetch_dy[3:1]};
+        sprite_fetch_pending <= 1;
+        sprite_fetch_latch <= sprite_fetch_index;
+        sprite_fetch_hit <= sprite_fetch_on_line;
+        sprite_fetch_index <= sprite_fetch_index + 1;
+        sprite_fetching <= sprite_fetch_index != SPRITES-1;
+      end else if(line_fetch && ~char_state[2]) begin
+        display_access = 1;
+        display_addr = attr_table_base + char_addr;
       end
-      vram_base <= attr_table_base;
-      vram_offset <= char_addr;
-      vram_write_enable <= 0;
+      display_fetch <= line_fetch && ~char_state[2];
     end
-    2: begin
-      next_char_attrs <= vram_data_out;
-      vram_base <= name_table_base;
-      vram_offset <= char_addr;
-      vram_write_enable <= 0;
+    2: if(display_fetch) begin
+      display_access = 1;
+      display_addr = name_table_base + char_addr;
     end
-    3: begin
-      vram_base <= pattern_table_base;
-      vram_offset <= {5'b0, vram_data_out, char_row[3:1]};
-      vram_write_enable <= 0;
+    3: if(display_fetch && ~pattern_rom) begin
+      display_access = 1;
+      display_addr = pattern_table_base + {5'b0, display_data_out, char_row[3:1]};
     end
   endcase
+
+  // The CPU port takes the block not used by the display. Queued writes go
+  // first, then the read-ahead and then the block engine, which only runs
+  // once no writes are queued and the read-ahead has been fetched.
+  port_access = 0;
+  port_write = 0;
+  port_addr = 16'h0000;
+  port_data = 8'h00;
+  engine_addr = (engine_copy && ~engine_have_data) ? engine_src_ctr : engine_dst_ctr;
+
+  vram_cpu_read <= 0;
+  engine_read_pending <= 0;
+
+  if(~write_fifo_empty) begin
+    if(~display_access || (write_address[15] != display_addr[15])) begin
+      port_access = 1;
+      port_write = 1;
+      port_addr = write_address;
+      port_data = write_fifo[write_fifo_tail];
+      vram_fifo_write_toggle <= ~vram_fifo_write_toggle;
+    end
+  end else if(~read_valid && ~read_in_flight) begin
+    if(~display_access || (read_address[15] != display_addr[15])) begin
+      port_access = 1;
+      port_addr = read_address;
+      vram_cpu_read <= 1;
+      vram_read_issue_toggle <= ~vram_read_issue_toggle;
+    end
+  end else if(engine_busy) begin
+    if(~display_access || (engine_addr[15] != display_addr[15])) begin
+      port_access = 1;
+      port_addr = engine_addr;
+
+      if(engine_copy && ~engine_have_data) begin
+        engine_src_ctr <= engine_src_ctr + 1;
+        engine_have_data <= 1;
+        engine_read_pending <= 1;
+      end else begin
+        port_write = 1;
+        port_data = ~engine_copy ? engine_fill_value :
+          (engine_read_pending ? port_data_out : engine_data);
+        engine_dst_ctr <= engine_dst_ctr + 1;
+        engine_remaining <= engine_remaining - 1;
+        engine_have_data <= 0;
+        engine_busy <= engine_remaining != 1;
+      end
+    end
+  end
+
+  vram_low_write_enable <= 0;
+  vram_high_write_enable <= 0;
+
+  if(display_access) begin
+    display_bank <= display_addr[15];
+    if(display_addr[15]) begin
+      vram_high_addr <= display_addr[14:0];
+    end else begin
+      vram_low_addr <= display_addr[14:0];
+    end
+  end
+
+  if(port_access) begin
+    port_bank <= port_addr[15];
+    if(port_addr[15]) begin
+      vram_high_addr <= port_addr[14:0];
+      vram_high_write_enable <= port_write;
+      vram_high_data_in <= port_data;
+    end else begin
+      vram_low_addr <= port_addr[14:0];
+      vram_low_write_enable <= port_write;
+      vram_low_data_in <= port_data;
+    end
+  end
+
+  // Fetch sprites for the next visible line from the start of horizontal
+  // blank.
+  sprite_hv_reg <= h_visible;
+  if(sprite_hv_reg && ~h_visible) begin
+    sprite_fetching <= v_visible;
+    sprite_fetch_index <= 0;
+  end
+
+  // The character ROM is addressed alongside the VRAM pattern fetch. It is
+  // clocked in the same way so its data arrives in the same slot.
+  if(mem_state == 3) begin
+    charrom_addr <= {display_data_out, char_row[3:1]};
+    pattern_from_rom <= pattern_rom;
+  end
+
+  // Take a new engine command once any previous one has finished.
+  if(~engine_busy && (engine_start != engine_start_ack)) begin
+    engine_start_ack <= engine_start;
+    engine_src_ctr <= engine_src;
+    engine_dst_ctr <= engine_dst;
+    engine_remaining <= engine_length;
+    engine_copy <= engine_command == ENGINE_COPY;
+    engine_have_data <= 0;
+    engine_busy <= (engine_length != 0) &&
+      ((engine_command == ENGINE_FILL) || (engine_command == ENGINE_COPY));
+  end
 end
 
-wire [15:0] vram_addr = vram_base + vram_offset;
-spram32k8 vram(
+spram32k8 vram_low(
+  .clk(~dot_clk),
+  .addr(vram_low_addr),
+  .write_enable(vram_low_write_enable),
+  .data_in(vram_low_data_in),
+  .data_out(vram_low_data_out)
+);
+
+spram32k8 vram_high(
+  .clk(~dot_clk),
+  .addr(vram_high_addr),
+  .write_enable(vram_high_write_enable),
+  .data_in(vram_high_data_in),
+  .data_out(vram_high_data_out)
+);
+
+charrom charrom(
   .clk(~dot_clk),
-  .addr(vram_addr[14:0]),
-  .write_enable(vram_write_enable),
-  .data_in(vram_data_to_write),
-  .data_out(vram_data_out)
+  .addr(charrom_addr),
+  .data(charrom_data)
 );
 
-reg vram_we_reg;
+// The head of the write FIFO has been taken once its write is issued. Writes
+// may be issued in consecutive slots so each toggles vram_fifo_write_toggle
+// and the FIFO is popped on the clock after. This is before the next slot.
+reg vram_fifo_write_ack;
 always @(posedge clk) begin
-  vram_we_reg <= vram_write_enable;
+  vram_fifo_write_ack <= vram_fifo_write_toggle;
 end
 
+assign write_fifo_pop = vram_fifo_write_toggle != vram_fifo_write_ack;
+assign vram_write_done = write_fifo_pop;
+
+// Read-ahead fetches are passed to the CPU clock domain in the same way, on
+// the clock after the fetch is issued and after its data is latched.
+reg vram_read_issue_ack;
+reg vram_read_done_ack;
 always @(posedge clk) begin
-  if(reset) begin
-    vram_write_acknowledge <= 0;
-  end else begin
-    if(~vram_write_enable && vram_we_reg && vram_write_request) begin
-      vram_write_acknowledge <= 1;
-    end else if(vram_write_acknowledge) begin
-      vram_write_acknowledge <= vram_write_request;
-    end else begin
-      vram_write_acknowledge <= 0;
-    end
-  end
+  vram_read_issue_ack <= vram_read_issue_toggle;
+  vram_read_done_ack <= vram_read_done_toggle;
 end
 
-reg [2:0] char_state;
-reg hv_reg;
+assign read_fetch_issued = vram_read_issue_toggle != vram_read_issue_ack;
+assign read_fetch_done = vram_read_done_toggle != vram_read_done_ack;
+
+// The first dot of a line is the one after the first character is loaded.
+wire        line_first_dot = h_visible && (char_state == 7) && ~line_started;
+wire [10:0] line_dot_next = line_first_dot ? 11'd0 : (line_dot + 11'd1);
+wire [10:0] line_dots = {h_display_chars + 8'd1, 3'b000};
 assign px_colour = char_pattern[7] ? char_attrs[3:0] : char_attrs[7:4];
 
 always @(posedge dot_clk) begin
@@ -271,6 +786,11 @@ always @(posedge dot_clk) begin
     char_attrs <= 8'h00;
     char_state <= 0;
     hv_reg <= 0;
+    line_started <= 0;
+    line_dot <= 0;
+    for(sprite_j=0; sprite_j<SPRITES; sprite_j=sprite_j+1) begin
+      sprite_shift[sprite_j] <= 8'h00;
+    end
   end else begin
     if((char_state == 7) && h_visible) begin
       char_pattern <= next_char_pattern;
@@ -281,6 +801,24 @@ always @(posedge dot_clk) begin
 
     char_state <= (~h_visible && hv_reg) ? 1 : (char_state + 1);
     hv_reg <= h_visible;
+
+    px_history <= {px_history[23:0], visible ? px_colour : 4'h0};
+
+    if(line_first_dot) begin
+      line_started <= 1;
+    end else if(line_dot_next == line_dots) begin
+      line_started <= 0;
+    end
+    line_dot <= line_dot_next;
+
+    for(sprite_j=0; sprite_j<SPRITES; sprite_j=sprite_j+1) begin
+      if((line_first_dot || line_started) &&
+         (line_dot_next == {1'b0, sprite_x[sprite_j]})) begin
+        sprite_shift[sprite_j] <= sprite_line[sprite_j];
+      end else begin
+        sprite_shift[sprite_j] <= {sprite_shift[sprite_j][6:0], 1'b0};
+      end
+    end
   end
 end
 
@@ -300,17 +838,41 @@ always @(posedge char_clk) begin
     char_addr <= 0;
     char_row <= 0;
     start_char_addr <= 0;
+    char_col <= 0;
+    text_row <= 0;
+
+    scroll_row_addr <= 0;
+    scroll_row_ctr <= 0;
+    scroll_row_first <= 0;
   end else begin
-    char_addr <= h_visible ? char_addr + 1 : start_char_addr;
+    // Characters are fetched from the scrolled column onwards, wrapping at
+    // the end of the virtual row.
+    if(~h_visible) begin
+      char_col <= scroll_first_col;
+      char_addr <= start_char_addr + {8'h00, scroll_first_col};
+    end else if(char_col == (h_chars - 8'd1)) begin
+      char_col <= 0;
+      char_addr <= start_char_addr;
+    end else begin
+      char_col <= char_col + 1;
+      char_addr <= char_addr + 1;
+    end
+
+    // During vertical blank, multiply out the first row's offset by repeated
+    // addition. This restarts if the coarse vertical scroll is changed.
+    if(v_visible || (scroll_row_first != scroll_y_rows)) begin
+      scroll_row_addr <= 0;
+      scroll_row_ctr <= scroll_y_rows;
+      scroll_row_first <= scroll_y_rows;
+    end else if(scroll_row_ctr != 0) begin
+      scroll_row_addr <= scroll_row_addr + {8'h00, h_chars};
+      scroll_row_ctr <= scroll_row_ctr - 1;
+    end
 
     if(h_visible && (h_ctr == h_display_chars)) begin
       h_visible <= 0;
       h_ctr <= 0;
 
-      if(char_row == 4'hf) begin
-        start_char_addr <= v_visible ? (start_char_addr + {8'h00, h_chars}) : 0;
-      end
-
       if(v_visible && (v_ctr == {v_display_chars, 3'b111})) begin
         v_visible <= 0;
         v_ctr <= 0;
@@ -322,9 +884,21 @@ always @(posedge char_clk) begin
       end
 
       if(~v_visible && (v_ctr[7:0] == v_blank_lines)) begin
-        char_row <= 0;
+        char_row <= scroll_y_lines;
+        text_row <= scroll_row_first;
+        start_char_addr <= scroll_row_addr;
       end else begin
         char_row <= char_row + 1;
+
+        if(char_row == 4'hf) begin
+          if(text_row == (v_rows - 8'd1)) begin
+            text_row <= 0;
+            start_char_addr <= 0;
+          end else begin
+            text_row <= text_row + 1;
+            start_char_addr <= start_char_addr + {8'h00, h_chars};
+          end
+        end
       end
 
       if(~v_visible && (v_ctr[7:0] == v_front_porch_lines)) begin
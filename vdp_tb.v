@@ -17,18 +17,332 @@ module testbench;
   reg [1:0] mode = 0;
   reg read = 0;
   reg write = 0;
+  reg fast_write = 0;
   reg [7:0] data_in = 0;
-
+  wire [7:0] data_out;
+  wire rdy;
+  wire irq;
+  wire [3:0] r, g, b;
+  wire hsync, vsync;
+
+  // Reads and writes are strobed while cpu_clk is low. computer.v strobes each
+  // access for only the clock before the end of the CPU cycle and peripherals
+  // must behave the same for either. fast_write strobes writes on alternate
+  // system clocks, faster than any CPU, to find the limit of the VDP.
   vdp vdp(
     .clk(clk),
     .reset(reset),
+    .rdy(rdy),
+    .irq(irq),
 
     .mode(mode),
-    .read(read),
-    .write(write),
-    .data_in(data_in)
+    .read(read && ~cpu_clk),
+    .write((write && ~cpu_clk) || fast_write),
+    .data_in(data_in),
+    .data_out(data_out),
+
+    .r(r), .g(g), .b(b), .hsync(hsync), .vsync(vsync)
+  );
+
+  vga_capture capture(
+    .dot_clk(vdp.dot_clk),
+    .de(vdp.visible),
+    .r(r), .g(g), .b(b), .hsync(hsync), .vsync(vsync)
   );
 
+  // CPU cycle accounting
+  integer i;
+  integer cpu_cycles = 0;
+  integer stall_cycles = 0;
+
+  // Perform a single CPU write cycle. Like the 65C02, the write is repeated
+  // for as long as the VDP holds RDY low.
+  task cpu_write(input [1:0] write_mode, input [7:0] value);
+    begin
+      mode = write_mode;
+      data_in = value;
+      write = 1;
+      @(posedge cpu_clk);
+      cpu_cycles = cpu_cycles + 1;
+      while(~rdy) begin
+        stall_cycles = stall_cycles + 1;
+        cpu_cycles = cpu_cycles + 1;
+        @(posedge cpu_clk);
+      end
+      @(negedge cpu_clk);
+      write = 0;
+    end
+  endtask
+
+  // Perform a single CPU read cycle. As for writes, the read is repeated for
+  // as long as the VDP holds RDY low.
+  task cpu_read(input [1:0] read_mode, output [7:0] value);
+    begin
+      mode = read_mode;
+      read = 1;
+      @(posedge cpu_clk);
+      cpu_cycles = cpu_cycles + 1;
+      while(~rdy) begin
+        stall_cycles = stall_cycles + 1;
+        cpu_cycles = cpu_cycles + 1;
+        @(posedge cpu_clk);
+      end
+      value = data_out;
+      @(negedge cpu_clk);
+      read = 0;
+    end
+  endtask
+
+  task cpu_idle(input integer cycles);
+    begin
+      repeat (cycles) @(negedge cpu_clk);
+      cpu_cycles = cpu_cycles + cycles;
+    end
+  endtask
+
+  task set_reg(input [7:0] register, input [7:0] value);
+    begin
+      cpu_write(0, register);
+      cpu_write(1, value);
+    end
+  endtask
+
+  reg [7:0] status;
+
+  // Fill VRAM using the block engine and report how long the CPU had to poll
+  // the status register before the engine was idle.
+  task engine_fill(input [15:0] dst, input [15:0] length, input [7:0] value);
+    begin
+      cpu_cycles = 0;
+      set_reg(8'h14, dst[7:0]);
+      set_reg(8'h15, dst[15:8]);
+      set_reg(8'h16, length[7:0]);
+      set_reg(8'h17, length[15:8]);
+      set_reg(8'h18, value);
+      set_reg(8'h19, 8'h01);
+
+      status = 8'h40;
+      while(status & 8'h40) begin
+        cpu_read(3, status);
+      end
+
+      $display("Engine fill of %0d bytes: %0d CPU cycles", length, cpu_cycles);
+    end
+  endtask
+
+  // Enable the vertical blank interrupt, wait for it and check that writing
+  // to the status register acknowledges it.
+  task vblank_irq;
+    begin
+      cpu_write(3, 8'h30);
+      set_reg(8'h1a, 8'h01);
+
+      cpu_cycles = 0;
+      while(~irq) begin
+        cpu_idle(1);
+      end
+      cpu_read(3, status);
+      $display("Vertical blank IRQ after %0d CPU cycles, status %02x", cpu_cycles, status);
+
+      cpu_write(3, 8'h20);
+      cpu_idle(1);
+      if(irq) begin
+        $display("ERROR: IRQ still asserted after acknowledge");
+      end
+      set_reg(8'h1a, 8'h00);
+    end
+  endtask
+
+  // Write a burst of bytes to VRAM with a number of idle CPU cycles between
+  // each store and report how long the CPU spent stalled on RDY.
+  task vram_burst(input [15:0] addr, input integer length, input integer gap);
+    begin
+      set_reg(8'h02, addr[7:0]);
+      set_reg(8'h03, addr[15:8]);
+
+      cpu_cycles = 0;
+      stall_cycles = 0;
+      for(i=0; i<length; i=i+1) begin
+        cpu_write(2, i[7:0]);
+        cpu_idle(gap);
+      end
+
+      $display("VRAM burst of %0d bytes, one store per %0d cycles: %0d CPU cycles, %0d with RDY low",
+        length, gap + 1, cpu_cycles, stall_cycles);
+    end
+  endtask
+
+  // Read back a block of VRAM written by vram_burst, checking that each byte
+  // is the low byte of its index, and report how long the CPU spent stalled
+  // on RDY.
+  reg [7:0] read_value;
+  integer read_errors;
+
+  task vram_readback(input [15:0] addr, input integer length, input integer gap);
+    begin
+      set_reg(8'h00, addr[7:0]);
+      set_reg(8'h01, addr[15:8]);
+
+      cpu_cycles = 0;
+      stall_cycles = 0;
+      read_errors = 0;
+      for(i=0; i<length; i=i+1) begin
+        cpu_read(2, read_value);
+        if(read_value !== i[7:0]) begin
+          if(read_errors == 0) begin
+            $display("ERROR: VRAM read of %04x returned %02x, expected %02x",
+              addr + i, read_value, i[7:0]);
+          end
+          read_errors = read_errors + 1;
+        end
+        cpu_idle(gap);
+      end
+
+      $display("VRAM read of %0d bytes, one load per %0d cycles: %0d CPU cycles, %0d with RDY low, %0d errors",
+        length, gap + 1, cpu_cycles, stall_cycles, read_errors);
+    end
+  endtask
+
+  // Draw sprite 0 at (X, Y) with a pattern of two dots in each row and check
+  // that those dots are drawn on line Y+1, the second line of the first row.
+  integer sprite_dots;
+  integer sprite_first_dot;
+
+  task sprite_check(input [9:0] x, input [8:0] y);
+    begin
+      set_reg(8'h02, 8'h00);
+      set_reg(8'h03, 8'h30);
+      for(i=0; i<8; i=i+1) begin
+        cpu_write(2, 8'h81);
+      end
+      set_reg(8'h22, 8'h00);
+      set_reg(8'h23, 8'h30);
+      set_reg(8'h40, x[7:0]);
+      set_reg(8'h41, y[7:0]);
+      set_reg(8'h42, {1'b1, y[8], x[9:8], 4'he});
+      set_reg(8'h43, 8'h00);
+
+      // Wait for the start of the line in the next frame
+      wait(~vdp.v_visible);
+      wait(vdp.v_visible && (vdp.v_ctr == y + 1) && ~vdp.h_visible);
+      wait(vdp.h_visible);
+
+      sprite_dots = 0;
+      sprite_first_dot = -1;
+      while(vdp.h_visible) begin
+        @(posedge vdp.dot_clk);
+        if(vdp.sprite_px_set) begin
+          if(sprite_first_dot < 0) begin
+            sprite_first_dot = vdp.line_dot;
+          end
+          sprite_dots = sprite_dots + 1;
+        end
+      end
+
+      $display("Sprite at (%0d, %0d): %0d dots from dot %0d", x, y,
+        sprite_dots, sprite_first_dot);
+      if((sprite_dots != 2) || (sprite_first_dot != x)) begin
+        $display("ERROR: expected 2 dots from dot %0d", x);
+      end
+
+      set_reg(8'h42, 8'h00);
+    end
+  endtask
+
+  // Write to VRAM as fast as the write FIFO will take bytes and report the
+  // sustained rate at which they reach VRAM, either during the visible part
+  // of the frame or in vertical blank.
+  realtime throughput_start;
+  realtime throughput_time;
+
+  task vram_throughput(input [15:0] addr, input integer length, input in_vblank);
+    begin
+      set_reg(8'h02, addr[7:0]);
+      set_reg(8'h03, addr[15:8]);
+
+      if(in_vblank) begin
+        wait(vdp.v_visible);
+        wait(~vdp.v_visible);
+      end else begin
+        wait(~vdp.v_visible);
+        wait(vdp.v_visible);
+      end
+
+      mode = 2;
+      @(posedge clk);
+      throughput_start = $realtime;
+      for(i=0; i<length; i=i+1) begin
+        while(vdp.write_fifo_full) begin
+          @(posedge clk);
+        end
+        data_in = i[7:0];
+        fast_write = 1;
+        @(posedge clk);
+        fast_write = 0;
+        @(posedge clk);
+      end
+      while(~vdp.write_fifo_empty) begin
+        @(posedge clk);
+      end
+      throughput_time = $realtime - throughput_start;
+
+      // Memory slots are two system clocks long.
+      $display("VRAM write throughput, %0s: %0d bytes in %0.0f ns, %0.2f Mbytes/s, %0.0f%% of memory slots",
+        in_vblank ? "vertical blank" : "visible lines", length, throughput_time,
+        length * 1000.0 / throughput_time,
+        length * 100.0 * (2000.0 / 63) / throughput_time);
+
+      // The display fetches the name and attribute tables in two of every
+      // eight slots of a visible character and patterns come from the
+      // character ROM, so even writes to the same block get three of every
+      // four slots.
+      if(length * 4 * (2000.0 / 63) < throughput_time * 3) begin
+        $display("ERROR: VRAM writes took fewer than three of every four slots");
+      end
+    end
+  endtask
+
+  // Let the read-ahead fetch a byte and then overwrite a block starting at
+  // that byte as fast as the write FIFO will take it, so that it is popped
+  // many times before the read-ahead can be refetched. Reading the block back
+  // must return the new bytes.
+  task read_after_write(input [15:0] addr, input integer length);
+    begin
+      set_reg(8'h00, addr[7:0]);
+      set_reg(8'h01, addr[15:8]);
+      set_reg(8'h02, addr[7:0]);
+      set_reg(8'h03, addr[15:8]);
+      cpu_idle(16);
+
+      mode = 2;
+      @(posedge clk);
+      for(i=0; i<length; i=i+1) begin
+        while(vdp.write_fifo_full) begin
+          @(posedge clk);
+        end
+        data_in = ~i[7:0];
+        fast_write = 1;
+        @(posedge clk);
+        fast_write = 0;
+        @(posedge clk);
+      end
+
+      read_errors = 0;
+      for(i=0; i<length; i=i+1) begin
+        cpu_read(2, read_value);
+        if(read_value !== ~i[7:0]) begin
+          if(read_errors == 0) begin
+            $display("ERROR: VRAM read of %04x after writes returned %02x, expected %02x",
+              addr + i, read_value, ~i[7:0]);
+          end
+          read_errors = read_errors + 1;
+        end
+      end
+
+      $display("VRAM read after %0d fast writes: %0d errors", length, read_errors);
+    end
+  endtask
+
   reg [4095:0] vcdfile;
 
   initial begin
@@ -198,6 +512,43 @@ module testbench;
     write = 0;
     repeat (1) @(negedge cpu_clk);
 
+    // 80x30 screen clear as done by clear_attribute(), first with stores on
+    // every CPU cycle and then at the rate of a tight "sta abs" loop.
+    vram_burst(16'h0000, 2400, 0);
+    vram_burst(16'h0000, 2400, 3);
+
+    // The same clear using the block engine.
+    engine_fill(16'h0000, 16'd2400, 8'h20);
+
+    vblank_irq;
+
+    // Sustained VRAM write rate with the display running and without.
+    vram_throughput(16'h4000, 4096, 0);
+    vram_throughput(16'h4000, 4096, 1);
+
+    // The read-ahead must not survive writes to the byte it holds.
+    read_after_write(16'h4000, 64);
+
+    // Sprites, including one past the first 256 dots
+    sprite_check(10'd16, 9'd32);
+    sprite_check(10'd300, 9'd100);
+
+    // Set up a screen for frame capture with each name, attribute and
+    // pattern byte set to the low byte of its offset. Patterns come from VRAM
+    // rather than the character ROM.
+    set_reg(8'h11, 8'd80);
+    set_reg(8'h0f, 8'h00);
+    set_reg(8'h10, 8'h10);
+    set_reg(8'h21, 8'h00);
+    vram_burst(16'h0000, 2400, 0);
+    vram_burst(16'h1000, 2400, 0);
+    vram_burst(16'h2000, 2048, 0);
+
+    // Stream the name table back, at full speed and at the rate of a
+    // "lda abs" loop.
+    vram_readback(16'h0000, 2400, 0);
+    vram_readback(16'h0000, 2400, 3);
+
     repeat (1000000) @(posedge cpu_clk);
     $finish;
   end